@@ -2,6 +2,22 @@
 -- @file    premake5.lua
 --
 
+-- Build Options
+newoption {
+    trigger     = "simd",
+    value       = "LEVEL",
+    description = "The SIMD instruction set targeted by the APU batch kernels",
+    allowed     = {
+        { "sse2", "SSE2 (the x86-64 baseline)" },
+        { "avx2", "AVX2" }
+    },
+    default     = "sse2"
+}
+newoption {
+    trigger     = "profile",
+    description = "Time each music command parsed by the audio engine"
+}
+
 -- GSCA Workspace
 workspace "GSCA"
 
@@ -37,6 +53,12 @@ workspace "GSCA"
         defines {
             "GSCA_LINUX"
         }
+    filter { "options:simd=avx2" }
+        vectorextensions "AVX2"
+    filter { "options:profile" }
+        defines {
+            "GSCA_PROFILE"
+        }
     filter {}
 
     project "gsca"
@@ -82,3 +104,24 @@ workspace "GSCA"
         filter { "system:linux" }
             pic             "On"
         filter {}
+
+    project "gscabench"
+        kind        "ConsoleApp"
+        location    "./build/GSCABench"
+        targetdir   "./build/bin/%{cfg.buildcfg}"
+        objdir      "./build/obj/GSCABench/%{cfg.buildcfg}"
+        files       {
+            "./projects/GSCABench/**.h",
+            "./projects/GSCABench/**.c",
+            "./projects/GSCAB/Lexer.c",
+            "./projects/GSCAB/Builder.c",
+            "./projects/GSCAB/Token.c"
+        }
+        includedirs { "./projects" }
+        links       { "gsca", "physfs" }
+        
+        filter { "system:windows" }
+            systemversion   "latest"
+        filter { "system:linux" }
+            pic             "On"
+        filter {}
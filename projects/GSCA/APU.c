@@ -8,7 +8,6 @@
 
 typedef struct
 {
-    float       dacOutput;
     uint16_t    period;
     uint16_t    periodDivider;
     uint8_t     lengthTimer;
@@ -16,47 +15,237 @@ typedef struct
     uint8_t     wavePointer;
     uint8_t     frequencyTicks;
     uint8_t     envelopeTicks;
-    uint8_t     dacInput;
-    bool        dacEnable;
 } gscaPulseChannel;
 
 typedef struct
 {
-    float       dacOutput;
     uint16_t    period;
     uint16_t    periodDivider;
     uint8_t     lengthTimer;
     uint8_t     sampleIndex;
-    uint8_t     dacInput;
 } gscaWaveChannel;
 
 typedef struct
 {
-    float       dacOutput;
-    uint32_t    clockFrequency;
-    uint16_t    lfsr;
+    uint16_t    lfsrIndex;
+    uint8_t     lfsrHigh;
+    uint8_t     lfsrShortClocks;
+    bool        lfsrShort;
     uint8_t     lengthTimer;
     uint8_t     volume;
     uint8_t     envelopeTicks;
-    uint8_t     dacInput;
-    bool        dacEnable;
 } gscaNoiseChannel;
 
+/* Hot Channel State Structure ************************************************/
+
+/**
+ * Everything the channel clocks and the mixer read on each step, packed into
+ * one cache line: the channels' DAC inputs and outputs, and the settings which
+ * are decoded from the registers whenever they are written. Otherwise, the
+ * registers' bitfields are only read by `gscaReadNRxx`, by channel triggers
+ * and by the frame sequencer. Each array, and each bit of the bit masks, is
+ * indexed by channel (`GSCA_AC_*`), in the same order as the bits of `NR51`
+ * and `NR52`.
+ */
+typedef struct
+{
+    float       dacOutput[GSCA_AUDIO_CHANNEL_COUNT];
+    float       volumeLeft;
+    float       volumeRight;
+    int32_t     levelLeft;
+    int32_t     levelRight;
+    uint32_t    noiseFrequency;
+    int8_t      dacLevel[GSCA_AUDIO_CHANNEL_COUNT];
+    uint8_t     dacInput[GSCA_AUDIO_CHANNEL_COUNT];
+    uint8_t     dutyPattern[2];
+    uint8_t     waveShift;
+    uint8_t     enable;
+    uint8_t     dacEnable;
+    uint8_t     panLeft;
+    uint8_t     panRight;
+    bool        noiseShort;
+} __attribute__((aligned(64))) gscaHotState;
+
+static_assert(sizeof(gscaHotState) == 64, "Hot channel state must fit one cache line.");
+
+#define GSCA_CHANNEL_BIT(channel)   ((uint8_t) (1 << (channel)))
+
+/* DAC Output Levels **********************************************************/
+
+/**
+ * The DAC maps its 4-bit input onto an output level between `1.0` and `-1.0`.
+ * In the fixed-point pipeline, the same output levels are counted in
+ * fifteenths, as `15 - 2 * input`.
+ */
+#define GSCA_DAC_OUTPUT(input) (-(((float) (input) / 7.5f) - 1.0f))
+#define GSCA_DAC_LEVEL(input) ((int8_t) (15 - 2 * (input)))
+
+static const float GSCA_DAC_OUTPUTS[16] = {
+    GSCA_DAC_OUTPUT(0x0), GSCA_DAC_OUTPUT(0x1), GSCA_DAC_OUTPUT(0x2), GSCA_DAC_OUTPUT(0x3),
+    GSCA_DAC_OUTPUT(0x4), GSCA_DAC_OUTPUT(0x5), GSCA_DAC_OUTPUT(0x6), GSCA_DAC_OUTPUT(0x7),
+    GSCA_DAC_OUTPUT(0x8), GSCA_DAC_OUTPUT(0x9), GSCA_DAC_OUTPUT(0xA), GSCA_DAC_OUTPUT(0xB),
+    GSCA_DAC_OUTPUT(0xC), GSCA_DAC_OUTPUT(0xD), GSCA_DAC_OUTPUT(0xE), GSCA_DAC_OUTPUT(0xF)
+};
+
+/* Pulse Duty Patterns ********************************************************/
+
+static const uint8_t GSCA_DUTY_PATTERNS[4] = {
+    0b00000001, 0b00000011, 0b00001111, 0b00111111
+};
+
+/* Wave Output Shifts *********************************************************/
+
+/**
+ * The wave channel's output level, as a right shift of its 4-bit samples. A
+ * shift of 4 mutes the channel.
+ */
+static const uint8_t GSCA_WAVE_OUTPUT_SHIFTS[4] = { 4, 0, 1, 2 };
+
+/* Wave Pattern Bank **********************************************************/
+
+#define GSCA_DEFAULT_WAVE_PATTERN_COUNT 10
+
+/**
+ * The wave channel's built-in patterns, as they are written to wave RAM: two
+ * samples per byte, the first in the upper nibble.
+ */
+static const uint8_t GSCA_DEFAULT_WAVE_PATTERNS[GSCA_DEFAULT_WAVE_PATTERN_COUNT][GSCA_WAVE_RAM_SIZE] = {
+    { 0x02, 0x46, 0x8A, 0xCE, 0xFF, 0xFE, 0xDD, 0xCB, 0xBA, 0x98, 0x76, 0x54, 0x44, 0x33, 0x22, 0x11 },
+    { 0x02, 0x46, 0x8A, 0xCE, 0xEF, 0xFF, 0xFE, 0xEE, 0xCC, 0xBB, 0xA9, 0x87, 0x65, 0x43, 0x22, 0x11 },
+    { 0x13, 0x69, 0xBD, 0xEE, 0xEE, 0xFF, 0xFF, 0xED, 0xDE, 0xFF, 0xFF, 0xEE, 0xEE, 0xDB, 0x96, 0x31 },
+    { 0x02, 0x46, 0x8A, 0xCD, 0xEF, 0xFE, 0xDE, 0xFF, 0xEE, 0xDC, 0xBA, 0x98, 0x76, 0x54, 0x32, 0x10 },
+    { 0x01, 0x23, 0x45, 0x67, 0x8A, 0xCD, 0xEE, 0xF7, 0x7F, 0xEE, 0xDC, 0xA8, 0x76, 0x54, 0x32, 0x10 },
+    { 0x00, 0x11, 0x22, 0x33, 0x44, 0x33, 0x22, 0x11, 0xFF, 0xEE, 0xCC, 0xAA, 0x88, 0xAA, 0xCC, 0xEE },
+    { 0x02, 0x46, 0x8A, 0xCE, 0xCB, 0xA9, 0x87, 0x65, 0xFF, 0xFE, 0xED, 0xDC, 0x44, 0x33, 0x22, 0x11 },
+    { 0xC0, 0xA9, 0x87, 0xF5, 0xFF, 0xFE, 0xED, 0xDC, 0x44, 0x33, 0x22, 0xF1, 0x02, 0x46, 0x8A, 0xCE },
+    { 0x44, 0x33, 0x22, 0x1F, 0x00, 0x46, 0x8A, 0xCE, 0xF8, 0xFE, 0xED, 0xDC, 0xCB, 0xA9, 0x87, 0x65 },
+    { 0x11, 0x00, 0x00, 0x08, 0x00, 0x13, 0x57, 0x9A, 0xB4, 0xBA, 0xA9, 0x98, 0x87, 0x65, 0x43, 0x21 }
+};
+
+/* Noise LFSR Sequences *******************************************************/
+
+/**
+ * The noise channel's LFSR runs through one fixed sequence of states for each
+ * of its widths, starting from zero on a trigger. The bits it outputs along
+ * each sequence are packed into a table, with its first 64 bits repeated at
+ * the end so that 64 bits can be read from any position. The last position of
+ * each sequence stands for the LFSR's locked-up state (all ones), which never
+ * changes, and which is not part of the sequence.
+ */
+#define GSCA_NOISE_LONG_PERIOD  32767
+#define GSCA_NOISE_SHORT_PERIOD 127
+
+static uint64_t GSCA_NOISE_LONG_BITS[(GSCA_NOISE_LONG_PERIOD >> 6) + 2];
+static uint64_t GSCA_NOISE_SHORT_BITS[(GSCA_NOISE_SHORT_PERIOD >> 6) + 2];
+static uint16_t GSCA_NOISE_LONG_INDICES[0x8000];
+static uint8_t  GSCA_NOISE_SHORT_INDICES[0x80];
+
+/* Output Sample Formats ******************************************************/
+
+typedef enum
+{
+    GSCA_SF_F32,
+    GSCA_SF_S16,
+    GSCA_SF_S32
+} gscaSampleFormat;
+
+#define GSCA_CONVERT_BLOCK_SIZE         256
+
+typedef size_t (*gscaRenderKernel) (gscaAPU*, void*, gscaAudioSample* const*, size_t,
+    uint64_t, gscaSampleFormat);
+
+/* Band-Limited Output Structure *********************************************/
+
+typedef struct
+{
+    int32_t     kernel[GSCA_BLIP_PHASES + 1][GSCA_BLIP_TAPS];
+    int64_t     left[GSCA_BLIP_BUFFER_SIZE];
+    int64_t     right[GSCA_BLIP_BUFFER_SIZE];
+    int64_t     integratorLeft;
+    int64_t     integratorRight;
+    int32_t     levelLeft;
+    int32_t     levelRight;
+    uint32_t    index;
+} gscaBlipBuffer;
+
+/* Output Filter Chain Structure **********************************************/
+
+#define GSCA_FILTER_MAX_STAGES          3
+
+typedef float gscaStereoF32 __attribute__((vector_size(2 * sizeof(float))));
+
+typedef struct
+{
+    float       b0, b1, b2;
+    float       a1, a2;
+} gscaBiquad;
+
+/**
+ * The filter chain's biquads are run over whole buffers of output samples once
+ * they have been rendered, one stream at a time: the mixed output, then each
+ * channel's stem. Each stream keeps its own state, so that the filtered stems
+ * still add up to the filtered mix.
+ */
+typedef struct
+{
+    gscaBiquad      stages[GSCA_FILTER_MAX_STAGES];
+    gscaStereoF32   state[GSCA_AUDIO_CHANNEL_COUNT + 1][GSCA_FILTER_MAX_STAGES][2];
+    uint32_t        stageCount;
+    gscaEnum        model;
+    float           lowPassCutoff;
+} gscaFilterChain;
+
+/* Output Tap Structure *******************************************************/
+
+/**
+ * An extra sample clock, fed by the same channel emulation as the APU's own
+ * output. Each tap point-samples the mixed output at its own rate, and runs it
+ * through its own high-pass filter and filter chain, designed for that rate.
+ */
+typedef struct
+{
+    gscaFilterChain     filter;
+    gscaAudioSample     previousInput;
+    gscaAudioSample     previousOutput;
+    uint32_t            sampleRate;
+    uint32_t            samplePhase;
+} gscaOutputTap;
+
 /* APU Structure **************************************************************/
 
 typedef struct gscaAPU
 {
+    gscaHotState        hot;
     uint8_t             waveMemory[GSCA_WAVE_RAM_NIBBLE_SIZE];
-    gscaPulseChannel    pulse1;
-    gscaPulseChannel    pulse2;
+    gscaPulseChannel    pulse[2];
     gscaWaveChannel     wave;
     gscaNoiseChannel    noise;
     gscaAudioSample     currentSample;
     gscaAudioSample     previousInput;
     gscaAudioSample     previousOutput;
+    gscaAudioSample     previousStemInput[GSCA_AUDIO_CHANNEL_COUNT];
+    gscaAudioSample     previousStemOutput[GSCA_AUDIO_CHANNEL_COUNT];
+    int32_t             currentLevelLeft;
+    int32_t             currentLevelRight;
+    int32_t             previousInputLeft;
+    int32_t             previousInputRight;
+    int32_t             previousOutputLeft;
+    int32_t             previousOutputRight;
+    gscaFilterChain     filter;
+    gscaOutputTap       taps[GSCA_APU_MAX_OUTPUT_TAPS];
+    uint32_t            tapCount;
+    uint32_t            ditherState[GSCA_APU_BATCH_LANES];
+    gscaRenderKernel    renderKernel;
+    gscaEnum            accuracy;
+    gscaBlipBuffer*     blip;
+    gscaRegisterLog*    regLog;
+    const uint8_t       (*waveBank)[GSCA_WAVE_RAM_SIZE];
+    size_t              waveBankSize;
     uint32_t            ticks;
+    uint32_t            tickEpoch;
+    uint32_t            sampleRate;
+    uint32_t            samplePhase;
     uint16_t            divider;
-    uint16_t            clockFrequency;
     gscaMasterControl   nr52;
     gscaSoundPanning    nr51;
     gscaMasterVolume    nr50;
@@ -80,6 +269,119 @@ typedef struct gscaAPU
     gscaChannelControl  nr44;
 } gscaAPU;
 
+/* APU State Snapshot Structure *********************************************/
+
+#define GSCA_APU_STATE_MAGIC_NUMBER     0x53555041
+#define GSCA_APU_STATE_VERSION          8
+#define GSCA_APU_STATE_BLIP             0x0001
+
+/**
+ * A snapshot is this header, followed by the raw bytes of the APU structure,
+ * followed by the band-limited output stage's state (but not its kernel) if
+ * the header's flags say so.
+ */
+typedef struct
+{
+    uint32_t    magicNumber;    ///< @brief `$0000` - 4 byte magic identifier `APUS`.
+    uint16_t    version;        ///< @brief `$0004` - Snapshot version - must be `==` library's.
+    uint16_t    flags;          ///< @brief `$0006` - Snapshot flags.
+    uint32_t    apuSize;        ///< @brief `$0008` - Size of the APU structure, in bytes.
+    uint32_t    blipSize;       ///< @brief `$000C` - Size of the band-limited output state.
+} gscaAPUStateHeader;
+
+#define GSCA_BLIP_STATE_OFFSET  offsetof(gscaBlipBuffer, left)
+#define GSCA_BLIP_STATE_SIZE    (sizeof(gscaBlipBuffer) - GSCA_BLIP_STATE_OFFSET)
+
+/* APU Batch Structures *******************************************************/
+
+/**
+ * Each lane vector holds one element per APU in a batch. The compiler lowers
+ * operations on them to SSE2 instructions, or to AVX2 instructions when built
+ * with `premake5 --simd=avx2`.
+ */
+typedef uint16_t gscaLaneU16 __attribute__((vector_size(GSCA_APU_BATCH_LANES * sizeof(uint16_t))));
+typedef int16_t  gscaLaneI16 __attribute__((vector_size(GSCA_APU_BATCH_LANES * sizeof(int16_t))));
+typedef uint32_t gscaLaneU32 __attribute__((vector_size(GSCA_APU_BATCH_LANES * sizeof(uint32_t))));
+typedef int32_t  gscaLaneI32 __attribute__((vector_size(GSCA_APU_BATCH_LANES * sizeof(int32_t))));
+typedef float    gscaLaneF32 __attribute__((vector_size(GSCA_APU_BATCH_LANES * sizeof(float))));
+
+typedef struct
+{
+    gscaLaneU16 enable;
+    gscaLaneU16 period;
+    gscaLaneU16 periodDivider;
+    gscaLaneU16 wavePointer;
+    gscaLaneU16 dutyPattern;
+    gscaLaneU16 volume;
+    gscaLaneU16 dacInput;
+    gscaLaneF32 dacOutput;
+    gscaLaneI32 mixLeft;
+    gscaLaneI32 mixRight;
+} gscaPulseLanes;
+
+typedef struct
+{
+    gscaLaneU16 enable;
+    gscaLaneU16 period;
+    gscaLaneU16 periodDivider;
+    gscaLaneU16 sampleIndex;
+    gscaLaneU16 outputShift;
+    gscaLaneU16 dacInput;
+    gscaLaneF32 dacOutput;
+    gscaLaneI32 mixLeft;
+    gscaLaneI32 mixRight;
+} gscaWaveLanes;
+
+typedef struct
+{
+    gscaLaneU16 enable;
+    gscaLaneU32 clockFrequency;
+    gscaLaneU32 nextTick;
+    gscaLaneU16 lfsr;
+    gscaLaneU16 widthMask;
+    gscaLaneU16 volume;
+    gscaLaneU16 dacInput;
+    gscaLaneF32 dacOutput;
+    gscaLaneI32 mixLeft;
+    gscaLaneI32 mixRight;
+} gscaNoiseLanes;
+
+typedef struct
+{
+    gscaPulseLanes      pulse[2];
+    gscaWaveLanes       wave;
+    gscaNoiseLanes      noise;
+    gscaLaneF32         volumeLeft;
+    gscaLaneF32         volumeRight;
+    gscaLaneF32         previousInputLeft;
+    gscaLaneF32         previousInputRight;
+    gscaLaneF32         previousOutputLeft;
+    gscaLaneF32         previousOutputRight;
+    gscaLaneF32         currentLeft;
+    gscaLaneF32         currentRight;
+} gscaAPULanes;
+
+/**
+ * Vectors of lanes are selected between and converted to DAC outputs in
+ * macros, rather than functions, since the ABI for passing vectors wider than
+ * the target's registers by value differs between targets.
+ */
+#define GSCA_SELECT_LANES(mask, a, b) \
+    ((gscaLaneF32) (((gscaLaneI32) (a) & (mask)) | ((gscaLaneI32) (b) & ~(mask))))
+#define GSCA_DAC_OUTPUT_LANES(input) \
+    (-((__builtin_convertvector((input), gscaLaneF32) / 7.5f) - 1.0f))
+#define GSCA_WIDEN_LANES(mask) \
+    (__builtin_convertvector((gscaLaneI16) (mask), gscaLaneI32))
+
+typedef struct gscaAPUBatch
+{
+    gscaAPU*    lanes[GSCA_APU_BATCH_LANES];
+    size_t      laneCount;
+    uint32_t    ticks;
+    uint32_t    sampleRate;
+    uint32_t    samplePhase;
+} gscaAPUBatch;
+
 /* Static Function Prototypes *************************************************/
 
 static void gscaTriggerChannel (gscaAPU*, gscaEnum);
@@ -87,11 +389,74 @@ static void gscaResetPeriod (gscaAPU*, gscaEnum);
 static void gscaTickPulseChannels (gscaAPU*);
 static void gscaTickWaveChannel (gscaAPU*);
 static void gscaTickNoiseChannel (gscaAPU*);
+static void gscaInitNoiseTables ();
+static uint64_t gscaReadNoiseBits (const gscaNoiseChannel*);
+static uint16_t gscaGetNoiseLFSR (const gscaNoiseChannel*);
+static void gscaSetNoiseLFSR (gscaNoiseChannel*, uint16_t, bool);
+static void gscaAdvanceNoiseLFSR (gscaNoiseChannel*, uint32_t);
+static uint32_t gscaCountQuietNoiseClocks (const gscaAPU*);
 static void gscaTickLengthTimers (gscaAPU*);
 static void gscaTickFrequencySweep (gscaAPU*);
 static void gscaTickEnvelopeSweeps (gscaAPU*);
+static void gscaTickFrameSequencer (gscaAPU*);
 static void gscaUpdateNoiseClockFrequency (gscaAPU*);
+static void gscaLogRegisterWrite (gscaAPU*, uint8_t, uint8_t);
+static void gscaDecodeRegisters (gscaAPU*);
+static void gscaSetDACInput (gscaAPU*, gscaEnum, uint8_t);
+static bool gscaIsRegisterMapped (uint8_t);
+static void gscaApplyRegisterWrite (gscaAPU*, uint8_t, uint8_t);
+static void gscaMixAudioSample (const gscaAPU*, gscaAudioSample*);
+static void gscaHighPassFilter (gscaAudioSample*, gscaAudioSample*, const gscaAudioSample*,
+    gscaAudioSample*);
+static void gscaFilterAudioSample (gscaAPU*, const gscaAudioSample*);
 static void gscaUpdateAudioSample (gscaAPU*);
+static void gscaMixStemSample (const gscaAPU*, gscaEnum, gscaAudioSample*);
+static void gscaUpdateStemSamples (gscaAPU*, gscaAudioSample* const*, size_t);
+static void gscaMixAudioLevels (const gscaAPU*, int32_t*, int32_t*);
+static void gscaFilterAudioLevels (gscaAPU*, int32_t, int32_t);
+static void gscaUpdateAudioLevels (gscaAPU*);
+static void gscaDesignHighPass (gscaBiquad*, double, double);
+static void gscaDesignLowPass (gscaBiquad*, double, double);
+static void gscaInitFilterChain (gscaFilterChain*, uint32_t);
+static void gscaInitOutputTaps (gscaAPU*);
+static void gscaApplyFilterChain (gscaFilterChain*, size_t, gscaAudioSample*, size_t);
+static void gscaInitBlipBuffer (gscaAPU*);
+static void gscaAddBlipDelta (gscaAPU*);
+static void gscaReadBlipLevels (gscaAPU*, int64_t*, int64_t*);
+static void gscaStepAPU (gscaAPU*);
+static uint32_t gscaPeriodSteps (uint16_t);
+static uint32_t gscaCyclesToNextEdge (const gscaAPU*);
+static void gscaSkipCycles (gscaAPU*, uint32_t);
+static void gscaAdvancePulseChannel (gscaAPU*, gscaEnum, uint32_t);
+static void gscaAdvanceWaveChannel (gscaAPU*, uint32_t);
+static void gscaAdvanceChannels (gscaAPU*, uint32_t);
+static void gscaEmitSample (gscaAPU*, void*, gscaAudioSample* const*, size_t,
+    gscaSampleFormat);
+static bool gscaIsAPUSilent (const gscaAPU*);
+static void gscaSkipSilentFrames (gscaAPU*, size_t);
+static size_t gscaRenderSilence (gscaAPU*, void*, gscaAudioSample* const*, size_t, size_t,
+    gscaSampleFormat);
+static size_t gscaRenderExact (gscaAPU*, void*, gscaAudioSample* const*, size_t,
+    uint64_t, gscaSampleFormat);
+static size_t gscaRenderCoarse (gscaAPU*, void*, gscaAudioSample* const*, size_t,
+    uint64_t, gscaSampleFormat);
+static size_t gscaRenderSamples (gscaAPU*, void*, gscaAudioSample* const*, size_t,
+    uint64_t, gscaSampleFormat);
+static bool gscaAnyLane (const gscaLaneU16*);
+static int32_t gscaMinLane (const gscaLaneI32*);
+static void gscaMinLanes (gscaLaneI32*, const gscaLaneI32*);
+static uint32_t gscaCyclesToNextLaneEdge (const gscaAPUBatch*, const gscaAPULanes*);
+static void gscaSkipLaneCycles (gscaAPUBatch*, gscaAPULanes*, uint32_t);
+static void gscaGatherAPULanes (const gscaAPUBatch*, gscaAPULanes*);
+static void gscaScatterAPULanes (gscaAPUBatch*, const gscaAPULanes*);
+static void gscaTickPulseLanes (gscaPulseLanes*);
+static void gscaTickWaveLanes (const gscaAPUBatch*, gscaWaveLanes*);
+static void gscaTickNoiseLanes (gscaNoiseLanes*, uint32_t);
+static void gscaMixAPULanes (gscaAPULanes*);
+static void gscaConvertSamples (gscaAPU*, const gscaOutputFormat*, void* const*, size_t,
+    const gscaAudioSample*, size_t);
+static size_t gscaRenderFormatted (gscaAPU*, const gscaOutputFormat*, void* const*, size_t,
+    uint64_t);
 
 /* Static Functions ***********************************************************/
 
@@ -102,7 +467,7 @@ void gscaTriggerChannel (gscaAPU* apu, gscaEnum type)
     {
         case GSCA_AC_PULSE1:
         {
-            gscaPulseChannel* chan = &apu->pulse1;
+            gscaPulseChannel* chan = &apu->pulse[GSCA_AC_PULSE1];
             chan->lengthTimer = apu->nr11.initialLengthTimer;
             chan->volume = apu->nr12.initialVolume;
             chan->period = (apu->nr14.periodHigh << 8) | apu->nr13.periodLow;
@@ -110,11 +475,12 @@ void gscaTriggerChannel (gscaAPU* apu, gscaEnum type)
             chan->wavePointer = 0;
             chan->frequencyTicks = 0;
             chan->envelopeTicks = 0;
-            apu->nr52.pulse1Enable = chan->dacEnable;
+            gscaChangeBit(apu->hot.enable, GSCA_AC_PULSE1,
+                gscaCheckBit(apu->hot.dacEnable, GSCA_AC_PULSE1));
         } break;
         case GSCA_AC_PULSE2:
         {
-            gscaPulseChannel* chan = &apu->pulse2;
+            gscaPulseChannel* chan = &apu->pulse[GSCA_AC_PULSE2];
             chan->lengthTimer = apu->nr21.initialLengthTimer;
             chan->volume = apu->nr22.initialVolume;
             chan->period = (apu->nr24.periodHigh << 8) | apu->nr23.periodLow;
@@ -122,7 +488,8 @@ void gscaTriggerChannel (gscaAPU* apu, gscaEnum type)
             chan->wavePointer = 0;
             chan->frequencyTicks = 0;
             chan->envelopeTicks = 0;
-            apu->nr52.pulse2Enable = chan->dacEnable;
+            gscaChangeBit(apu->hot.enable, GSCA_AC_PULSE2,
+                gscaCheckBit(apu->hot.dacEnable, GSCA_AC_PULSE2));
         } break;
         case GSCA_AC_WAVE:
         {
@@ -131,16 +498,21 @@ void gscaTriggerChannel (gscaAPU* apu, gscaEnum type)
             chan->period = (apu->nr34.periodHigh << 8) | apu->nr33.periodLow;
             chan->periodDivider = chan->period;
             chan->sampleIndex = 0;
-            apu->nr52.waveEnable = apu->nr30.enable;
+            gscaChangeBit(apu->hot.enable, GSCA_AC_WAVE,
+                gscaCheckBit(apu->hot.dacEnable, GSCA_AC_WAVE));
         } break;
         case GSCA_AC_NOISE:
         {
             gscaNoiseChannel* chan = &apu->noise;
             chan->lengthTimer = apu->nr41.initialLengthTimer;
             chan->volume = apu->nr42.initialVolume;
-            chan->lfsr = 0;
+            chan->lfsrIndex = 0;
+            chan->lfsrHigh = 0;
+            chan->lfsrShortClocks = 0;
+            chan->lfsrShort = apu->hot.noiseShort;
             chan->envelopeTicks = 0;
-            apu->nr52.noiseEnable = chan->dacEnable;
+            gscaChangeBit(apu->hot.enable, GSCA_AC_NOISE,
+                gscaCheckBit(apu->hot.dacEnable, GSCA_AC_NOISE));
         } break;
     }
 }
@@ -150,14 +522,14 @@ static void gscaResetPeriod (gscaAPU* apu, gscaEnum type)
     switch (type)
     {
         case GSCA_AC_PULSE1:
-            apu->pulse1.period =
+            apu->pulse[type].period =
                 (apu->nr13.periodLow | (apu->nr14.periodHigh << 8));
-            apu->pulse1.periodDivider = apu->pulse1.period;
+            apu->pulse[type].periodDivider = apu->pulse[type].period;
             break;
         case GSCA_AC_PULSE2:
-            apu->pulse2.period =
+            apu->pulse[type].period =
                 (apu->nr23.periodLow | (apu->nr24.periodHigh << 8));
-            apu->pulse2.periodDivider = apu->pulse2.period;
+            apu->pulse[type].periodDivider = apu->pulse[type].period;
             break;
         case GSCA_AC_WAVE:
             apu->wave.period =
@@ -170,107 +542,218 @@ static void gscaResetPeriod (gscaAPU* apu, gscaEnum type)
 
 void gscaTickPulseChannels (gscaAPU* apu)
 {
-    static const uint8_t WAVE_DUTY_PATTERNS[] = {
-        0b00000001, 0b00000011, 0b00001111, 0b00111111
-    };
-
-    gscaPulseChannel* chan = &apu->pulse1;
-    if (apu->nr52.pulse1Enable && ++chan->periodDivider > 0x800)
-    {
-        chan->periodDivider = chan->period;
-        chan->wavePointer = (chan->wavePointer + 1) & 0b111;
-        chan->dacInput =
-            (WAVE_DUTY_PATTERNS[apu->nr11.waveDuty] >> chan->wavePointer) & 0b1;
-        chan->dacInput *= chan->volume;
-        chan->dacOutput = -(((float) chan->dacInput / 7.5f) - 1.0f);
-    }
-
-    chan = &apu->pulse2;
-    if (apu->nr52.pulse2Enable && ++chan->periodDivider > 0x800)
+    for (gscaEnum i = GSCA_AC_PULSE1; i <= GSCA_AC_PULSE2; ++i)
     {
-        chan->periodDivider = chan->period;
-        chan->wavePointer = (chan->wavePointer + 1) & 0b111;
-        chan->dacInput =
-            (WAVE_DUTY_PATTERNS[apu->nr21.waveDuty] >> chan->wavePointer) & 0b1;
-        chan->dacInput *= chan->volume;
-        chan->dacOutput = -(((float) chan->dacInput / 7.5f) - 1.0f);
+        gscaPulseChannel* chan = &apu->pulse[i];
+        if (gscaCheckBit(apu->hot.enable, i) && ++chan->periodDivider > 0x800)
+        {
+            chan->periodDivider = chan->period;
+            chan->wavePointer = (chan->wavePointer + 1) & 0b111;
+            gscaSetDACInput(apu, i,
+                ((apu->hot.dutyPattern[i] >> chan->wavePointer) & 0b1) * chan->volume);
+        }
     }
 }
 
 void gscaTickWaveChannel (gscaAPU* apu)
 {
     gscaWaveChannel* chan = &apu->wave;
-    if (apu->nr52.waveEnable && ++chan->periodDivider > 0x800)
+    if (gscaCheckBit(apu->hot.enable, GSCA_AC_WAVE) && ++chan->periodDivider > 0x800)
     {
         chan->periodDivider = chan->period;
         chan->sampleIndex = (chan->sampleIndex + 1) & 0b11111;
-        chan->dacInput = apu->waveMemory[chan->sampleIndex];
-        switch (apu->nr32.outputLevel)
-        {
-            case GSCA_WOL_MUTE:     chan->dacInput = 0; break;
-            case GSCA_WOL_FULL:     break;
-            case GSCA_WOL_HALF:     chan->dacInput >>= 1; break;
-            case GSCA_WOL_QUARTER:  chan->dacInput >>= 2; break;
-        }
-        chan->dacOutput = -(((float) chan->dacInput / 7.5f) - 1.0f);
+        gscaSetDACInput(apu, GSCA_AC_WAVE,
+            apu->waveMemory[chan->sampleIndex] >> apu->hot.waveShift);
     }
 }
 
 void gscaTickNoiseChannel (gscaAPU* apu)
 {
     gscaNoiseChannel* chan = &apu->noise;
-    if (apu->nr52.noiseEnable)
+    if (gscaCheckBit(apu->hot.enable, GSCA_AC_NOISE))
+    {
+        uint8_t bit;
+        if (chan->lfsrShort == apu->hot.noiseShort)
+        {
+            bit = gscaReadNoiseBits(chan) & 0b1;
+            gscaAdvanceNoiseLFSR(chan, 1);
+        }
+        else
+        {
+            // The LFSR's width has changed since it was last clocked. Clock it
+            // bit by bit, then look up its state in the new width's sequence.
+            uint16_t lfsr = gscaGetNoiseLFSR(chan);
+            bit = ((lfsr & 0b1) == ((lfsr >> 1) & 0b1));
+
+            lfsr |= (bit << 15);
+            if (apu->hot.noiseShort) { lfsr |= (bit << 7); }
+
+            lfsr >>= 1;
+            lfsr &= ~(1 << 15);
+            if (apu->hot.noiseShort) { lfsr &= ~(1 << 7); }
+
+            gscaSetNoiseLFSR(chan, lfsr, apu->hot.noiseShort);
+        }
+
+        gscaSetDACInput(apu, GSCA_AC_NOISE, bit * chan->volume);
+    }
+}
+
+void gscaInitNoiseTables ()
+{
+    static bool initialized = false;
+    if (initialized) { return; }
+
+    // Run the LFSR bit by bit from zero through each sequence, recording the
+    // bits it outputs and the position of each state it passes through.
+    for (int width = 0; width < 2; ++width)
     {
-        uint8_t bit = ((chan->lfsr & 0b1) == ((chan->lfsr >> 1) & 0b1));
+        uint64_t* bits = (width) ? GSCA_NOISE_SHORT_BITS : GSCA_NOISE_LONG_BITS;
+        size_t count = 64 * ((width) ? sizeof(GSCA_NOISE_SHORT_BITS) : sizeof(GSCA_NOISE_LONG_BITS)) / 8;
+        uint32_t period = (width) ? GSCA_NOISE_SHORT_PERIOD : GSCA_NOISE_LONG_PERIOD;
+        uint16_t lfsr = 0;
+
+        if (width) { memset(GSCA_NOISE_SHORT_INDICES, period, sizeof(GSCA_NOISE_SHORT_INDICES)); }
+        else
+        {
+            for (size_t i = 0; i < 0x8000; ++i)
+                { GSCA_NOISE_LONG_INDICES[i] = period; }
+        }
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (i < period)
+            {
+                if (width) { GSCA_NOISE_SHORT_INDICES[lfsr & 0x7F] = i; }
+                else       { GSCA_NOISE_LONG_INDICES[lfsr & 0x7FFF] = i; }
+            }
+
+            uint8_t bit = ((lfsr & 0b1) == ((lfsr >> 1) & 0b1));
+            lfsr |= (bit << 15);
+            if (width) { lfsr |= (bit << 7); }
+            lfsr >>= 1;
+            lfsr &= ~(1 << 15);
+            if (width) { lfsr &= ~(1 << 7); }
+
+            if (bit) { bits[i >> 6] |= (1ull << (i & 63)); }
+            else     { bits[i >> 6] &= ~(1ull << (i & 63)); }
+        }
+    }
+
+    initialized = true;
+}
+
+uint64_t gscaReadNoiseBits (const gscaNoiseChannel* chan)
+{
+    // The next 64 bits which the LFSR will output, starting from bit 0.
+    const uint64_t* bits = (chan->lfsrShort) ? GSCA_NOISE_SHORT_BITS : GSCA_NOISE_LONG_BITS;
+    uint32_t period = (chan->lfsrShort) ? GSCA_NOISE_SHORT_PERIOD : GSCA_NOISE_LONG_PERIOD;
+    if (chan->lfsrIndex == period) { return UINT64_MAX; }
+
+    uint32_t word = chan->lfsrIndex >> 6, shift = chan->lfsrIndex & 63;
+    return (shift == 0) ? bits[word] :
+        (bits[word] >> shift) | (bits[word + 1] << (64 - shift));
+}
+
+uint16_t gscaGetNoiseLFSR (const gscaNoiseChannel* chan)
+{
+    // The LFSR's state holds the last 15 (or 7) bits it has output, with the
+    // latest one in the top bit.
+    uint32_t period = (chan->lfsrShort) ? GSCA_NOISE_SHORT_PERIOD : GSCA_NOISE_LONG_PERIOD;
+    uint32_t length = (chan->lfsrShort) ? 7 : 15;
+    uint16_t mask = (1 << length) - 1;
+
+    gscaNoiseChannel past = *chan;
+    if (chan->lfsrIndex != period)
+        { past.lfsrIndex = (chan->lfsrIndex + period - length) % period; }
+    uint16_t lfsr = gscaReadNoiseBits(&past) & mask;
+    if (!chan->lfsrShort) { return lfsr; }
+
+    // In 7-bit mode, bits 8 to 14 are shifted in from the top with the same
+    // output bits as bits 0 to 6, so that they catch up after 7 clocks.
+    uint8_t clocks = chan->lfsrShortClocks;
+    uint8_t high = (clocks >= 7) ? lfsr :
+        (chan->lfsrHigh >> clocks) | (lfsr & (0x7F << (7 - clocks)) & 0x7F);
+    return lfsr | (high << 8);
+}
 
-        chan->lfsr |= (bit << 15);
-        if (apu->nr43.lfsrWidth) { chan->lfsr |= (bit << 7); }
+void gscaSetNoiseLFSR (gscaNoiseChannel* chan, uint16_t lfsr, bool lfsrShort)
+{
+    // The state must have been reached by clocking the LFSR at the given width,
+    // which leaves bit 15 (and, in 7-bit mode, bit 7) clear.
+    chan->lfsrShort = lfsrShort;
+    chan->lfsrIndex = (lfsrShort) ?
+        GSCA_NOISE_SHORT_INDICES[lfsr & 0x7F] :
+        GSCA_NOISE_LONG_INDICES[lfsr & 0x7FFF];
+    chan->lfsrHigh = (lfsr >> 8) & 0x7F;
+    chan->lfsrShortClocks = 0;
+}
 
-        chan->lfsr >>= 1;
-        chan->lfsr &= ~(1 << 15);
-        if (apu->nr43.lfsrWidth) { chan->lfsr &= ~(1 << 7); }
+void gscaAdvanceNoiseLFSR (gscaNoiseChannel* chan, uint32_t clocks)
+{
+    uint32_t period = (chan->lfsrShort) ? GSCA_NOISE_SHORT_PERIOD : GSCA_NOISE_LONG_PERIOD;
+    if (chan->lfsrIndex != period)
+        { chan->lfsrIndex = (chan->lfsrIndex + clocks) % period; }
 
-        chan->dacInput = bit * chan->volume;
-        chan->dacOutput = -(((float) chan->dacInput / 7.5f) - 1.0f);
+    if (chan->lfsrShort)
+    {
+        chan->lfsrShortClocks = (clocks >= 7u - chan->lfsrShortClocks) ? 7 :
+            chan->lfsrShortClocks + clocks;
     }
 }
 
+uint32_t gscaCountQuietNoiseClocks (const gscaAPU* apu)
+{
+    // The number of upcoming clocks of the noise channel, up to 64, which will
+    // leave its DAC input unchanged.
+    const gscaNoiseChannel* chan = &apu->noise;
+    const uint8_t dacInput = apu->hot.dacInput[GSCA_AC_NOISE];
+    if (chan->lfsrShort != apu->hot.noiseShort) { return 0; }
+    if (chan->volume == 0) { return (dacInput == 0) ? 64 : 0; }
+
+    uint64_t bits = gscaReadNoiseBits(chan);
+    if (dacInput == 0) { bits = ~bits; }
+    else if (dacInput != chan->volume) { return 0; }
+
+    return (bits == UINT64_MAX) ? 64 : (uint32_t) __builtin_ctzll(~bits);
+}
+
 void gscaTickLengthTimers (gscaAPU* apu)
 {
-    gscaPulseChannel* pchan = &apu->pulse1;
-    if (apu->nr52.pulse1Enable && apu->nr14.lengthEnable)
+    gscaPulseChannel* pchan = &apu->pulse[GSCA_AC_PULSE1];
+    if (gscaCheckBit(apu->hot.enable, GSCA_AC_PULSE1) && apu->nr14.lengthEnable)
     {
         if (++pchan->lengthTimer >= 0b111111)
-            apu->nr52.pulse1Enable = false;
+            gscaClearBit(apu->hot.enable, GSCA_AC_PULSE1);
     }
 
-    pchan = &apu->pulse2;
-    if (apu->nr52.pulse2Enable && apu->nr24.lengthEnable)
+    pchan = &apu->pulse[GSCA_AC_PULSE2];
+    if (gscaCheckBit(apu->hot.enable, GSCA_AC_PULSE2) && apu->nr24.lengthEnable)
     {
         if (++pchan->lengthTimer >= 0b111111)
-            apu->nr52.pulse2Enable = false;
+            gscaClearBit(apu->hot.enable, GSCA_AC_PULSE2);
     }
 
     gscaWaveChannel* wchan = &apu->wave;
-    if (apu->nr52.waveEnable && apu->nr34.lengthEnable)
+    if (gscaCheckBit(apu->hot.enable, GSCA_AC_WAVE) && apu->nr34.lengthEnable)
     {
         if (++wchan->lengthTimer == 0b11111111)
-            apu->nr52.waveEnable = false;
+            gscaClearBit(apu->hot.enable, GSCA_AC_WAVE);
     }
 
     gscaNoiseChannel* nchan = &apu->noise;
-    if (apu->nr52.noiseEnable && apu->nr44.lengthEnable)
+    if (gscaCheckBit(apu->hot.enable, GSCA_AC_NOISE) && apu->nr44.lengthEnable)
     {
         if (++nchan->lengthTimer >= 0b111111)
-            apu->nr52.noiseEnable = false;
+            gscaClearBit(apu->hot.enable, GSCA_AC_NOISE);
     }
 }
 
 void gscaTickFrequencySweep (gscaAPU* apu)
 {
-    gscaPulseChannel* chan = &apu->pulse1;
+    gscaPulseChannel* chan = &apu->pulse[GSCA_AC_PULSE1];
 
-    if (apu->nr52.pulse1Enable && apu->nr10.individualStep)
+    if (gscaCheckBit(apu->hot.enable, GSCA_AC_PULSE1) && apu->nr10.individualStep)
     {
         uint16_t periodDelta = (chan->period >> apu->nr10.individualStep);
         if (
@@ -278,7 +761,7 @@ void gscaTickFrequencySweep (gscaAPU* apu)
             chan->period + periodDelta > 0x7FF
         )
         {
-            apu->nr52.pulse1Enable = false;
+            gscaClearBit(apu->hot.enable, GSCA_AC_PULSE1);
             return;
         }
 
@@ -297,8 +780,8 @@ void gscaTickFrequencySweep (gscaAPU* apu)
 
 void gscaTickEnvelopeSweeps (gscaAPU* apu)
 {
-    gscaPulseChannel* pchan = &apu->pulse1;
-    if (apu->nr52.pulse1Enable && apu->nr12.sweepPace > 0)
+    gscaPulseChannel* pchan = &apu->pulse[GSCA_AC_PULSE1];
+    if (gscaCheckBit(apu->hot.enable, GSCA_AC_PULSE1) && apu->nr12.sweepPace > 0)
     {
         if (++pchan->envelopeTicks >= apu->nr12.sweepPace)
         {
@@ -321,8 +804,8 @@ void gscaTickEnvelopeSweeps (gscaAPU* apu)
         }
     }
 
-    pchan = &apu->pulse2;
-    if (apu->nr52.pulse2Enable && apu->nr22.sweepPace > 0)
+    pchan = &apu->pulse[GSCA_AC_PULSE2];
+    if (gscaCheckBit(apu->hot.enable, GSCA_AC_PULSE2) && apu->nr22.sweepPace > 0)
     {
         if (++pchan->envelopeTicks >= apu->nr22.sweepPace)
         {
@@ -346,7 +829,7 @@ void gscaTickEnvelopeSweeps (gscaAPU* apu)
     }
 
     gscaNoiseChannel* nchan = &apu->noise;
-    if (apu->nr52.noiseEnable && apu->nr42.sweepPace > 0)
+    if (gscaCheckBit(apu->hot.enable, GSCA_AC_NOISE) && apu->nr42.sweepPace > 0)
     {
         if (++nchan->envelopeTicks >= apu->nr42.sweepPace)
         {
@@ -370,213 +853,2218 @@ void gscaTickEnvelopeSweeps (gscaAPU* apu)
     }
 }
 
+void gscaTickFrameSequencer (gscaAPU* apu)
+{
+    // The tick counter wraps around on a frame sequencer step, so this is also
+    // where the upper half of the APU's cycle count is advanced.
+    if (apu->ticks == 0)
+        { apu->tickEpoch++; }
+
+    apu->divider++;
+    if (apu->divider % 2 == 0)
+        { gscaTickLengthTimers(apu); }
+    if (apu->divider % 4 == 0)
+        { gscaTickFrequencySweep(apu); }
+    if (apu->divider % 8 == 0)
+        { gscaTickEnvelopeSweeps(apu); }
+}
+
 void gscaUpdateNoiseClockFrequency (gscaAPU* apu)
 {
-    gscaNoiseChannel* chan = &apu->noise;
+    uint32_t clockFrequency;
     if (apu->nr43.clockDivider == 0)
     {
-        chan->clockFrequency = 262144 / (0.5 * pow(2, apu->nr43.clockShift));
+        clockFrequency = 262144 / (0.5 * pow(2, apu->nr43.clockShift));
     }
     else
     {
-        chan->clockFrequency =
+        clockFrequency =
             262144 / (apu->nr43.clockDivider * pow(2, apu->nr43.clockShift));
     }
 
-    chan->clockFrequency = (4194304.0f / chan->clockFrequency);
+    apu->hot.noiseFrequency = (4194304.0f / clockFrequency);
 }
 
-void gscaUpdateAudioSample (gscaAPU* apu)
+void gscaLogRegisterWrite (gscaAPU* apu, uint8_t address, uint8_t value)
 {
-    static const float HPF_ALPHA = 0.999958f;
-
-    gscaAudioSample* sample = &apu->currentSample;
-    gscaAudioSample* in = &apu->previousInput;
-    gscaAudioSample* out = &apu->previousOutput;
-
-    sample->left = 0.0f;
-    sample->right = 0.0f;
-
-    if (apu->nr52.pulse1Enable && apu->pulse1.dacEnable)
-    {
-        if (apu->nr51.pulse1Left)
-            sample->left += apu->pulse1.dacOutput;
-        if (apu->nr51.pulse1Right)
-            sample->right += apu->pulse1.dacOutput;
-    }
-
-    if (apu->nr52.pulse2Enable && apu->pulse2.dacEnable)
-    {
-        if (apu->nr51.pulse2Left)
-            sample->left += apu->pulse2.dacOutput;
-        if (apu->nr51.pulse2Right)
-            sample->right += apu->pulse2.dacOutput;
-    }
-
-    if (apu->nr52.waveEnable && apu->nr30.enable)
+    if (apu->regLog != NULL)
     {
-        if (apu->nr51.waveLeft)
-            sample->left += apu->wave.dacOutput;
-        if (apu->nr51.waveRight)
-            sample->right += apu->wave.dacOutput;
+        gscaAppendRegisterLog(apu->regLog, gscaGetAPUCycles(apu), address, value);
     }
-
-    if (apu->nr52.noiseEnable && apu->noise.dacEnable)
-    {
-        if (apu->nr51.noiseLeft)
-            sample->left += apu->noise.dacOutput;
-        if (apu->nr51.noiseRight)
-            sample->right += apu->noise.dacOutput;
-    }
-
-    sample->left  *= (0.125f * (apu->nr50.leftVolume  + 1));
-    sample->right *= (0.125f * (apu->nr50.rightVolume + 1));
-
-    float newLeft  = sample->left  - in->left  + HPF_ALPHA * out->left;
-    float newRight = sample->right - in->right + HPF_ALPHA * out->right;
-    in->left = sample->left; in->right = sample->right;
-    sample->left = newLeft; sample->right = newRight;
-    out->left = newLeft; out->right = newRight;
-    sample->left /= 4.0f; sample->right /= 4.0f;
 }
 
-/* Public Functions ***********************************************************/
-
-gscaAPU* gscaCreateAPU ()
+void gscaDecodeRegisters (gscaAPU* apu)
 {
-    gscaAPU* apu = gscaCreateZero(1, gscaAPU);
-    gscaExpectp(apu, "Cannot create APU context");
-    gscaResetAPU(apu);
-    return apu;
+    // The channel enable bits, the pulse and noise channels' DAC enable bits
+    // and the noise channel's clock frequency change with more than just the
+    // register writes, so they are kept up to date where they change instead.
+    gscaHotState* hot = &apu->hot;
+    hot->volumeLeft = 0.125f * (apu->nr50.leftVolume + 1);
+    hot->volumeRight = 0.125f * (apu->nr50.rightVolume + 1);
+    hot->levelLeft = apu->nr50.leftVolume + 1;
+    hot->levelRight = apu->nr50.rightVolume + 1;
+    hot->panLeft = apu->nr51.value >> 4;
+    hot->panRight = apu->nr51.value & 0xF;
+    hot->dutyPattern[GSCA_AC_PULSE1] = GSCA_DUTY_PATTERNS[apu->nr11.waveDuty];
+    hot->dutyPattern[GSCA_AC_PULSE2] = GSCA_DUTY_PATTERNS[apu->nr21.waveDuty];
+    hot->waveShift = GSCA_WAVE_OUTPUT_SHIFTS[apu->nr32.outputLevel];
+    hot->noiseShort = apu->nr43.lfsrWidth;
+    gscaChangeBit(hot->dacEnable, GSCA_AC_WAVE, apu->nr30.enable);
 }
 
-void gscaResetAPU (gscaAPU* apu)
+void gscaSetDACInput (gscaAPU* apu, gscaEnum channel, uint8_t input)
 {
-    gscaExpect(apu, "Pointer 'apu' is NULL.\n");
-    gscaZero(apu, 1, gscaAPU);
-    apu->nr52.value = 0xF1;
-    apu->nr51.value = 0xF3;
-    apu->nr50.value = 0x77;
-    apu->nr10.value = 0x80;
-    apu->nr11.value = 0xBF;
-    apu->nr12.value = 0xF3;
-    apu->nr13.value = 0xFF;
-    apu->nr14.value = 0xBF;
-    apu->nr21.value = 0x3F;
-    apu->nr22.value = 0x00;
-    apu->nr23.value = 0xFF;
-    apu->nr24.value = 0xBF;
-    apu->nr30.value = 0x7F;
-    apu->nr31.value = 0xFF;
-    apu->nr32.value = 0x9F;
-    apu->nr33.value = 0xFF;
-    apu->nr34.value = 0xBF;
-    apu->nr41.value = 0xFF;
-    apu->nr42.value = 0x00;
-    apu->nr43.value = 0x00;
-    apu->nr44.value = 0xBF;
-    apu->clockFrequency = 4194304 / GSCA_DEFAULT_SAMPLE_RATE;
-    gscaUpdateNoiseClockFrequency(apu);
+    apu->hot.dacInput[channel] = input;
+    apu->hot.dacOutput[channel] = GSCA_DAC_OUTPUTS[input];
+    apu->hot.dacLevel[channel] = GSCA_DAC_LEVEL(input);
 }
 
-void gscaDestroyAPU (gscaAPU* apu)
+bool gscaIsRegisterMapped (uint8_t address)
 {
-    if (apu != NULL)
+    switch (address)
     {
-        gscaDestroy(apu);
+        case GSCA_AR_NR10: case GSCA_AR_NR11: case GSCA_AR_NR12: case GSCA_AR_NR13:
+        case GSCA_AR_NR14: case GSCA_AR_NR21: case GSCA_AR_NR22: case GSCA_AR_NR23:
+        case GSCA_AR_NR24: case GSCA_AR_NR30: case GSCA_AR_NR31: case GSCA_AR_NR32:
+        case GSCA_AR_NR33: case GSCA_AR_NR34: case GSCA_AR_NR41: case GSCA_AR_NR42:
+        case GSCA_AR_NR43: case GSCA_AR_NR44: case GSCA_AR_NR50: case GSCA_AR_NR51:
+        case GSCA_AR_NR52:
+            return true;
+        default:
+            return address >= GSCA_AR_WAVE_RAM &&
+                address < GSCA_AR_WAVE_RAM + GSCA_WAVE_RAM_SIZE;
     }
 }
 
-const gscaAudioSample* gscaGetCurrentSample (const gscaAPU* apu)
-{
-    gscaExpect(apu, "Pointer 'apu' is NULL.\n");
-    return &apu->currentSample;
-}
-
-bool gscaSetWavePattern (gscaAPU* apu, const char* pattern)
+void gscaApplyRegisterWrite (gscaAPU* apu, uint8_t address, uint8_t value)
 {
-    gscaExpect(apu, "Pointer 'apu' is NULL.\n");
-    gscaExpect(pattern, "Pointer 'pattern' is NULL.\n");
+    gscaLogRegisterWrite(apu, address, value);
 
-    if (strlen(pattern) != GSCA_WAVE_RAM_NIBBLE_SIZE)
+    // Wave RAM stays writable while the APU is powered off, and `NR52` is what
+    // powers it back on. Every other register ignores writes while it is off.
+    if (address >= GSCA_AR_WAVE_RAM)
     {
-        gscaErr("Wave pattern string must be 32 characters in length.\n");
-        return false;
+        size_t index = (address - GSCA_AR_WAVE_RAM) * 2;
+        apu->waveMemory[index] = (value >> 4) & 0xF;
+        apu->waveMemory[index + 1] = value & 0xF;
+        return;
     }
-
-    for (int i = 0; i < GSCA_WAVE_RAM_NIBBLE_SIZE; ++i)
+    else if (address == GSCA_AR_NR52)
     {
-        char c = pattern[i];
-        if (!isxdigit(c))
+        apu->nr52.value |= (value & 0b11110000);
+        if (apu->nr52.masterEnable == false)
         {
-            gscaErr("Wave pattern character %d ('%c') is not hexadecimal.\n",
-                i, c);
-            return false;
+            apu->nr52.value = 0x00;
+            apu->nr51.value = 0x00;
+            apu->nr50.value = 0x00;
+            apu->nr10.value = 0x00;
+            apu->nr11.value = 0x00;
+            apu->nr12.value = 0x00;
+            apu->nr13.value = 0x00;
+            apu->nr14.value = 0x00;
+            apu->nr21.value = 0x00;
+            apu->nr22.value = 0x00;
+            apu->nr23.value = 0x00;
+            apu->nr24.value = 0x00;
+            apu->nr30.value = 0x00;
+            apu->nr31.value = 0x00;
+            apu->nr32.value = 0x00;
+            apu->nr33.value = 0x00;
+            apu->nr34.value = 0x00;
+            apu->nr41.value = 0x00;
+            apu->nr42.value = 0x00;
+            apu->nr43.value = 0x00;
+            apu->nr44.value = 0x00;
+            apu->hot.enable = 0;
+            gscaDecodeRegisters(apu);
         }
 
-        apu->waveMemory[i] = (strtoul(&c, NULL, 16) & 0xF);
+        return;
     }
-
-    return true;
-}
-
-bool gscaTickAPU (gscaAPU* apu)
-{
-    gscaExpect(apu, "Pointer 'apu' is NULL.\n");
-
-    bool bitWasHigh = (gscaCheckBit((apu->ticks++), 12) == 1);
-    bool bitNowLow  = (gscaCheckBit( apu->ticks,    12) == 0);
-
-    if (apu->ticks % 2 == 0)
-        { gscaTickWaveChannel(apu); }
-    if (apu->ticks % 4 == 0)
-        { gscaTickPulseChannels(apu); }
-    if (apu->ticks % apu->noise.clockFrequency == 0)
-        { gscaTickNoiseChannel(apu); }
-
-    if (bitWasHigh && bitNowLow)
+    else if (apu->nr52.masterEnable == false)
     {
-        apu->divider++;
-        if (apu->divider % 2 == 0)
-            { gscaTickLengthTimers(apu); }
-        if (apu->divider % 4 == 0)
-            { gscaTickFrequencySweep(apu); }
-        if (apu->divider % 8 == 0)
-            { gscaTickEnvelopeSweeps(apu); }
+        return;
     }
 
-    if (apu->ticks % apu->clockFrequency == 0)
-        { gscaUpdateAudioSample(apu); return true; }
-
-    return false;
-}
-
-uint8_t gscaReadNR52 (const gscaAPU* apu)
-{
-    gscaExpect(apu, "Pointer 'apu' is NULL.\n");
-    return apu->nr52.value;
-}
-
-uint8_t gscaReadNR51 (const gscaAPU* apu)
-{
-    gscaExpect(apu, "Pointer 'apu' is NULL.\n");
-    return apu->nr51.value;
-}
-
-uint8_t gscaReadNR50 (const gscaAPU* apu)
-{
-    gscaExpect(apu, "Pointer 'apu' is NULL.\n");
-    return apu->nr50.value;
-}
-
-uint8_t gscaReadNR10 (const gscaAPU* apu)
-{
-    gscaExpect(apu, "Pointer 'apu' is NULL.\n");
-    return apu->nr10.value;
-}
-
-uint8_t gscaReadNR11 (const gscaAPU* apu)
-{
+    switch (address)
+    {
+        case GSCA_AR_NR51:
+            apu->nr51.value = value;
+            gscaDecodeRegisters(apu);
+            break;
+        case GSCA_AR_NR50:
+            apu->nr50.value = value;
+            gscaDecodeRegisters(apu);
+            break;
+        case GSCA_AR_NR10: apu->nr10.value = value; break;
+        case GSCA_AR_NR11:
+            apu->nr11.value = value;
+            gscaDecodeRegisters(apu);
+            break;
+        case GSCA_AR_NR12:
+            apu->nr12.value = value;
+            if (
+                apu->nr12.envelopeDirection == GSCA_ESD_DECREASE &&
+                apu->nr12.initialVolume == 0
+            )
+            {
+                gscaClearBit(apu->hot.dacEnable, GSCA_AC_PULSE1);
+                gscaClearBit(apu->hot.enable, GSCA_AC_PULSE1);
+            }
+            else
+            {
+                gscaSetBit(apu->hot.dacEnable, GSCA_AC_PULSE1);
+            }
+            break;
+        case GSCA_AR_NR13:
+            apu->nr13.value = value;
+            gscaResetPeriod(apu, GSCA_AC_PULSE1);
+            break;
+        case GSCA_AR_NR14:
+            apu->nr14.value = value;
+            gscaResetPeriod(apu, GSCA_AC_PULSE1);
+            if (apu->nr14.trigger == true)
+            {
+                gscaTriggerChannel(apu, GSCA_AC_PULSE1);
+            }
+            break;
+        case GSCA_AR_NR21:
+            apu->nr21.value = value;
+            gscaDecodeRegisters(apu);
+            break;
+        case GSCA_AR_NR22:
+            apu->nr22.value = value;
+            if (
+                apu->nr22.envelopeDirection == GSCA_ESD_DECREASE &&
+                apu->nr22.initialVolume == 0
+            )
+            {
+                gscaClearBit(apu->hot.dacEnable, GSCA_AC_PULSE2);
+                gscaClearBit(apu->hot.enable, GSCA_AC_PULSE2);
+            }
+            else
+            {
+                gscaSetBit(apu->hot.dacEnable, GSCA_AC_PULSE2);
+            }
+            break;
+        case GSCA_AR_NR23:
+            apu->nr23.value = value;
+            gscaResetPeriod(apu, GSCA_AC_PULSE2);
+            break;
+        case GSCA_AR_NR24:
+            apu->nr24.value = value;
+            gscaResetPeriod(apu, GSCA_AC_PULSE2);
+            if (apu->nr24.trigger == true)
+            {
+                gscaTriggerChannel(apu, GSCA_AC_PULSE2);
+            }
+            break;
+        case GSCA_AR_NR30:
+            apu->nr30.value = value;
+            gscaDecodeRegisters(apu);
+            if (apu->nr30.enable == false)
+            {
+                gscaClearBit(apu->hot.enable, GSCA_AC_WAVE);
+            }
+            break;
+        case GSCA_AR_NR31: apu->nr31.value = value; break;
+        case GSCA_AR_NR32:
+            apu->nr32.value = value;
+            gscaDecodeRegisters(apu);
+            break;
+        case GSCA_AR_NR33:
+            apu->nr33.value = value;
+            gscaResetPeriod(apu, GSCA_AC_WAVE);
+            break;
+        case GSCA_AR_NR34:
+            apu->nr34.value = value;
+            gscaResetPeriod(apu, GSCA_AC_WAVE);
+            if (apu->nr34.trigger == true)
+            {
+                gscaTriggerChannel(apu, GSCA_AC_WAVE);
+            }
+            break;
+        case GSCA_AR_NR41: apu->nr41.value = value; break;
+        case GSCA_AR_NR42:
+            apu->nr42.value = value;
+            if (
+                apu->nr42.envelopeDirection == GSCA_ESD_DECREASE &&
+                apu->nr42.initialVolume == 0
+            )
+            {
+                gscaClearBit(apu->hot.dacEnable, GSCA_AC_NOISE);
+                gscaClearBit(apu->hot.enable, GSCA_AC_NOISE);
+            }
+            else
+            {
+                gscaSetBit(apu->hot.dacEnable, GSCA_AC_NOISE);
+            }
+            break;
+        case GSCA_AR_NR43:
+            apu->nr43.value = value;
+            gscaDecodeRegisters(apu);
+            gscaUpdateNoiseClockFrequency(apu);
+            break;
+        case GSCA_AR_NR44:
+            apu->nr44.value = value;
+            if (apu->nr44.trigger == true)
+            {
+                gscaTriggerChannel(apu, GSCA_AC_NOISE);
+            }
+            break;
+        default: break;
+    }
+}
+
+void gscaMixAudioSample (const gscaAPU* apu, gscaAudioSample* sample)
+{
+    const gscaHotState* hot = &apu->hot;
+    const uint8_t on = hot->enable & hot->dacEnable;
+    const uint8_t left = on & hot->panLeft, right = on & hot->panRight;
+
+    sample->left = 0.0f;
+    sample->right = 0.0f;
+
+    for (gscaEnum i = 0; i < GSCA_AUDIO_CHANNEL_COUNT; ++i)
+    {
+        if (gscaCheckBit(left, i))  { sample->left  += hot->dacOutput[i]; }
+        if (gscaCheckBit(right, i)) { sample->right += hot->dacOutput[i]; }
+    }
+
+    sample->left  *= hot->volumeLeft;
+    sample->right *= hot->volumeRight;
+}
+
+void gscaHighPassFilter (gscaAudioSample* in, gscaAudioSample* out,
+    const gscaAudioSample* mix, gscaAudioSample* sample)
+{
+    static const float HPF_ALPHA = 0.999958f;
+
+    float newLeft  = mix->left  - in->left  + HPF_ALPHA * out->left;
+    float newRight = mix->right - in->right + HPF_ALPHA * out->right;
+    in->left = mix->left; in->right = mix->right;
+    sample->left = newLeft; sample->right = newRight;
+    out->left = newLeft; out->right = newRight;
+    sample->left /= 4.0f; sample->right /= 4.0f;
+}
+
+void gscaFilterAudioSample (gscaAPU* apu, const gscaAudioSample* mix)
+{
+    gscaHighPassFilter(&apu->previousInput, &apu->previousOutput, mix,
+        &apu->currentSample);
+}
+
+void gscaUpdateAudioSample (gscaAPU* apu)
+{
+    static const float BLIP_SCALE =
+        1.0f / (120.0f * GSCA_BLIP_LEVEL_SCALE * GSCA_BLIP_KERNEL_SCALE);
+
+    if (apu->blip != NULL)
+    {
+        int64_t left, right;
+        gscaReadBlipLevels(apu, &left, &right);
+
+        gscaAudioSample mix = {
+            .left  = (float) left  * BLIP_SCALE,
+            .right = (float) right * BLIP_SCALE
+        };
+        gscaFilterAudioSample(apu, &mix);
+        return;
+    }
+
+    gscaMixAudioSample(apu, &apu->currentSample);
+    gscaFilterAudioSample(apu, &apu->currentSample);
+}
+
+void gscaMixStemSample (const gscaAPU* apu, gscaEnum channel,
+    gscaAudioSample* sample)
+{
+    const gscaHotState* hot = &apu->hot;
+    const uint8_t on = hot->enable & hot->dacEnable;
+    const uint8_t left = on & hot->panLeft, right = on & hot->panRight;
+
+    sample->left  = gscaCheckBit(left,  channel) ? hot->dacOutput[channel] : 0.0f;
+    sample->right = gscaCheckBit(right, channel) ? hot->dacOutput[channel] : 0.0f;
+    sample->left  *= hot->volumeLeft;
+    sample->right *= hot->volumeRight;
+}
+
+void gscaUpdateStemSamples (gscaAPU* apu, gscaAudioSample* const* stems,
+    size_t frame)
+{
+    // Each stem is panned, scaled by the master volume and high-pass filtered
+    // on its own, so that the stems add up to the mixed output.
+    for (gscaEnum i = 0; i < GSCA_AUDIO_CHANNEL_COUNT; ++i)
+    {
+        gscaAudioSample mix;
+        gscaMixStemSample(apu, i, &mix);
+        gscaHighPassFilter(&apu->previousStemInput[i],
+            &apu->previousStemOutput[i], &mix, &mix);
+        if (stems[i] != NULL) { stems[i][frame] = mix; }
+    }
+}
+
+void gscaMixAudioLevels (const gscaAPU* apu, int32_t* left, int32_t* right)
+{
+    // The mixed levels are counted in 120ths: fifteenths from the DACs, scaled
+    // by eighths from the master volume.
+    const gscaHotState* hot = &apu->hot;
+    const uint8_t on = hot->enable & hot->dacEnable;
+    const uint8_t mixLeft = on & hot->panLeft, mixRight = on & hot->panRight;
+    int32_t l = 0, r = 0;
+
+    for (gscaEnum i = 0; i < GSCA_AUDIO_CHANNEL_COUNT; ++i)
+    {
+        if (gscaCheckBit(mixLeft, i))   { l += hot->dacLevel[i]; }
+        if (gscaCheckBit(mixRight, i))  { r += hot->dacLevel[i]; }
+    }
+
+    *left  = l * hot->levelLeft;
+    *right = r * hot->levelRight;
+}
+
+void gscaFilterAudioLevels (gscaAPU* apu, int32_t left, int32_t right)
+{
+    // The same high-pass filter as `gscaFilterAudioSample`, on mixed levels in
+    // 16.16 fixed point, with its coefficient in 2.30 fixed point.
+    static const int64_t HPF_ALPHA = 1073696727;
+
+    int32_t newLeft = left - apu->previousInputLeft + (int32_t)
+        ((HPF_ALPHA * apu->previousOutputLeft + (1 << 29)) >> 30);
+    int32_t newRight = right - apu->previousInputRight + (int32_t)
+        ((HPF_ALPHA * apu->previousOutputRight + (1 << 29)) >> 30);
+
+    apu->previousInputLeft = left;
+    apu->previousInputRight = right;
+    apu->previousOutputLeft = newLeft;
+    apu->previousOutputRight = newRight;
+    apu->currentLevelLeft = newLeft;
+    apu->currentLevelRight = newRight;
+}
+
+void gscaUpdateAudioLevels (gscaAPU* apu)
+{
+    int32_t left, right;
+
+    if (apu->blip != NULL)
+    {
+        int64_t blipLeft, blipRight;
+        gscaReadBlipLevels(apu, &blipLeft, &blipRight);
+
+        // The blip buffer's levels are already in 16.16 fixed point, scaled
+        // by its kernel.
+        left = (int32_t) (blipLeft >> 15);
+        right = (int32_t) (blipRight >> 15);
+    }
+    else
+    {
+        gscaMixAudioLevels(apu, &left, &right);
+        left *= GSCA_BLIP_LEVEL_SCALE;
+        right *= GSCA_BLIP_LEVEL_SCALE;
+    }
+
+    gscaFilterAudioLevels(apu, left, right);
+}
+
+void gscaDesignHighPass (gscaBiquad* biquad, double cutoff, double sampleRate)
+{
+    // Second-order Butterworth high-pass, from the RBJ audio EQ cookbook.
+    double w0 = 2.0 * 3.14159265358979323846 * cutoff / sampleRate;
+    double alpha = sin(w0) / (2.0 * 0.70710678118654752);
+    double a0 = 1.0 + alpha;
+
+    biquad->b0 = (float) ((1.0 + cos(w0)) / 2.0 / a0);
+    biquad->b1 = (float) (-(1.0 + cos(w0)) / a0);
+    biquad->b2 = biquad->b0;
+    biquad->a1 = (float) (-2.0 * cos(w0) / a0);
+    biquad->a2 = (float) ((1.0 - alpha) / a0);
+}
+
+void gscaDesignLowPass (gscaBiquad* biquad, double cutoff, double sampleRate)
+{
+    // Second-order Butterworth low-pass, from the RBJ audio EQ cookbook.
+    double w0 = 2.0 * 3.14159265358979323846 * cutoff / sampleRate;
+    double alpha = sin(w0) / (2.0 * 0.70710678118654752);
+    double a0 = 1.0 + alpha;
+
+    biquad->b0 = (float) ((1.0 - cos(w0)) / 2.0 / a0);
+    biquad->b1 = (float) ((1.0 - cos(w0)) / a0);
+    biquad->b2 = biquad->b0;
+    biquad->a1 = (float) (-2.0 * cos(w0) / a0);
+    biquad->a2 = (float) ((1.0 - alpha) / a0);
+}
+
+void gscaInitFilterChain (gscaFilterChain* filter, uint32_t rate)
+{
+    // The DMG's and CGB's output capacitors charge by a fixed factor on every
+    // clock cycle, which makes a one-pole high-pass filter; raising the factor
+    // to the number of cycles per sample gives its per-sample coefficient.
+    static const double DMG_CHARGE_FACTOR = 0.999958;
+    static const double CGB_CHARGE_FACTOR = 0.998943;
+
+    const double sampleRate = rate;
+    gscaZero(filter->stages, GSCA_FILTER_MAX_STAGES, gscaBiquad);
+    memset(filter->state, 0, sizeof(filter->state));
+    filter->stageCount = 0;
+
+    switch (filter->model)
+    {
+        case GSCA_FM_DMG:
+        case GSCA_FM_CGB:
+        {
+            double factor = (filter->model == GSCA_FM_DMG) ?
+                DMG_CHARGE_FACTOR : CGB_CHARGE_FACTOR;
+            gscaBiquad* biquad = &filter->stages[filter->stageCount++];
+            biquad->b0 = 1.0f;
+            biquad->b1 = -1.0f;
+            biquad->a1 = (float) -pow(factor, GSCA_CLOCK_RATE / sampleRate);
+        } break;
+        case GSCA_FM_AGB:
+            // The AGB's speaker passes little below a couple of hundred hertz,
+            // or above the lower treble.
+            gscaDesignHighPass(&filter->stages[filter->stageCount++], 180.0, sampleRate);
+            gscaDesignLowPass(&filter->stages[filter->stageCount++],
+                fmin(7000.0, sampleRate * 0.45), sampleRate);
+            break;
+        default:
+            break;
+    }
+
+    if (filter->lowPassCutoff > 0.0f)
+    {
+        gscaDesignLowPass(&filter->stages[filter->stageCount++],
+            fmin(filter->lowPassCutoff, sampleRate * 0.45), sampleRate);
+    }
+}
+
+void gscaInitOutputTaps (gscaAPU* apu)
+{
+    // The taps follow the APU's own filter model and low-pass cutoff, with
+    // their filter chains designed for their own sample rates.
+    for (uint32_t i = 0; i < apu->tapCount; ++i)
+    {
+        gscaOutputTap* tap = &apu->taps[i];
+        tap->filter.model = apu->filter.model;
+        tap->filter.lowPassCutoff = apu->filter.lowPassCutoff;
+        gscaInitFilterChain(&tap->filter, tap->sampleRate);
+    }
+}
+
+void gscaApplyFilterChain (gscaFilterChain* filter, size_t stream,
+    gscaAudioSample* samples, size_t count)
+{
+    // Each stage is a transposed direct form II biquad. The recursion runs
+    // from one sample to the next, so the left and right channels are filtered
+    // side by side in one vector instead.
+    for (uint32_t i = 0; i < filter->stageCount; ++i)
+    {
+        const gscaBiquad* biquad = &filter->stages[i];
+        gscaStereoF32 z1 = filter->state[stream][i][0];
+        gscaStereoF32 z2 = filter->state[stream][i][1];
+
+        for (size_t frame = 0; frame < count; ++frame)
+        {
+            gscaStereoF32 x = { samples[frame].left, samples[frame].right };
+            gscaStereoF32 y = biquad->b0 * x + z1;
+            z1 = biquad->b1 * x - biquad->a1 * y + z2;
+            z2 = biquad->b2 * x - biquad->a2 * y;
+            samples[frame].left = y[0];
+            samples[frame].right = y[1];
+        }
+
+        filter->state[stream][i][0] = z1;
+        filter->state[stream][i][1] = z2;
+    }
+}
+
+void gscaInitBlipBuffer (gscaAPU* apu)
+{
+    static const double PI = 3.14159265358979323846;
+    static const double CUTOFF = 0.45;
+    static const int    SUBSTEPS = 64;
+
+    gscaBlipBuffer* blip = apu->blip;
+    gscaZero(blip, 1, gscaBlipBuffer);
+
+    // Each row of the kernel holds the band-limited step, differentiated into
+    // one delta per output sample, for a step which falls the given fraction of
+    // a sample period after the last output sample. The step response is a
+    // Blackman-windowed sinc, integrated numerically across each tap, centred
+    // `GSCA_BLIP_TAPS / 2` samples later.
+    const double half = GSCA_BLIP_TAPS / 2.0;
+    for (int phase = 0; phase <= GSCA_BLIP_PHASES; ++phase)
+    {
+        double fraction = (double) phase / GSCA_BLIP_PHASES;
+        double taps[GSCA_BLIP_TAPS];
+        double sum = 0.0;
+
+        for (int tap = 0; tap < GSCA_BLIP_TAPS; ++tap)
+        {
+            double area = 0.0;
+            for (int i = 0; i < SUBSTEPS; ++i)
+            {
+                double x = tap - half - fraction + (i + 0.5) / SUBSTEPS;
+                if (x <= -half || x >= half) { continue; }
+
+                double window = 0.42 + 0.5 * cos(PI * x / half) +
+                    0.08 * cos(2.0 * PI * x / half);
+                double sinc = (x == 0.0) ? 1.0 :
+                    sin(2.0 * PI * CUTOFF * x) / (2.0 * PI * CUTOFF * x);
+                area += 2.0 * CUTOFF * sinc * window / SUBSTEPS;
+            }
+
+            taps[tap] = area;
+            sum += area;
+        }
+
+        // Normalize each row so that its taps add up to exactly one step, then
+        // push the rounding error into the largest tap. This keeps the
+        // integrated output free of drift.
+        int32_t total = 0, largest = 0;
+        for (int tap = 0; tap < GSCA_BLIP_TAPS; ++tap)
+        {
+            blip->kernel[phase][tap] =
+                (int32_t) lround(taps[tap] * GSCA_BLIP_KERNEL_SCALE / sum);
+            total += blip->kernel[phase][tap];
+            if (blip->kernel[phase][tap] > blip->kernel[phase][largest])
+                { largest = tap; }
+        }
+
+        blip->kernel[phase][largest] += GSCA_BLIP_KERNEL_SCALE - total;
+    }
+
+    // Start from the APU's current output level, so that enabling the buffer
+    // does not introduce a step of its own.
+    gscaMixAudioLevels(apu, &blip->levelLeft, &blip->levelRight);
+    blip->levelLeft *= GSCA_BLIP_LEVEL_SCALE;
+    blip->levelRight *= GSCA_BLIP_LEVEL_SCALE;
+    blip->integratorLeft  = (int64_t) blip->levelLeft  * GSCA_BLIP_KERNEL_SCALE;
+    blip->integratorRight = (int64_t) blip->levelRight * GSCA_BLIP_KERNEL_SCALE;
+}
+
+void gscaAddBlipDelta (gscaAPU* apu)
+{
+    gscaBlipBuffer* blip = apu->blip;
+
+    int32_t left, right;
+    gscaMixAudioLevels(apu, &left, &right);
+    left *= GSCA_BLIP_LEVEL_SCALE;
+    right *= GSCA_BLIP_LEVEL_SCALE;
+    int32_t deltaLeft  = left  - blip->levelLeft;
+    int32_t deltaRight = right - blip->levelRight;
+    if (deltaLeft == 0 && deltaRight == 0) { return; }
+
+    blip->levelLeft = left;
+    blip->levelRight = right;
+
+    // The sample clock's phase is the fraction of a sample period which has
+    // elapsed since the last output sample. Round it to the nearest kernel
+    // phase.
+    uint32_t phase = (apu->samplePhase * GSCA_BLIP_PHASES + GSCA_CLOCK_RATE / 2) /
+        GSCA_CLOCK_RATE;
+    const int32_t* kernel = blip->kernel[phase];
+
+    for (int tap = 0; tap < GSCA_BLIP_TAPS; ++tap)
+    {
+        uint32_t index = (blip->index + tap) & (GSCA_BLIP_BUFFER_SIZE - 1);
+        blip->left[index]  += (int64_t) deltaLeft  * kernel[tap];
+        blip->right[index] += (int64_t) deltaRight * kernel[tap];
+    }
+}
+
+void gscaReadBlipLevels (gscaAPU* apu, int64_t* left, int64_t* right)
+{
+    gscaBlipBuffer* blip = apu->blip;
+    blip->integratorLeft  += blip->left[blip->index];
+    blip->integratorRight += blip->right[blip->index];
+    blip->left[blip->index] = 0;
+    blip->right[blip->index] = 0;
+    blip->index = (blip->index + 1) & (GSCA_BLIP_BUFFER_SIZE - 1);
+
+    *left = blip->integratorLeft;
+    *right = blip->integratorRight;
+}
+
+void gscaStepAPU (gscaAPU* apu)
+{
+    bool bitWasHigh = (gscaCheckBit((apu->ticks++), 12) == 1);
+    bool bitNowLow  = (gscaCheckBit( apu->ticks,    12) == 0);
+
+    if (apu->ticks % 2 == 0)
+        { gscaTickWaveChannel(apu); }
+    if (apu->ticks % 4 == 0)
+        { gscaTickPulseChannels(apu); }
+    if (apu->ticks % apu->hot.noiseFrequency == 0)
+        { gscaTickNoiseChannel(apu); }
+
+    if (bitWasHigh && bitNowLow)
+        { gscaTickFrameSequencer(apu); }
+}
+
+uint32_t gscaPeriodSteps (uint16_t periodDivider)
+{
+    // The number of period divider increments which remain until the divider
+    // overflows past `$800`.
+    return (periodDivider >= 0x800) ? 1 : (0x801 - periodDivider);
+}
+
+uint32_t gscaCyclesToNextEdge (const gscaAPU* apu)
+{
+    const uint32_t ticks = apu->ticks;
+
+    // The frame sequencer is clocked whenever bit 12 of the tick counter
+    // falls. This is also where the tick counter wraps around, so no other
+    // edge needs to account for the wrap.
+    uint32_t cycles = 0x2000 - (ticks & 0x1FFF);
+    uint32_t edge;
+
+    // The wave channel is clocked every 2 ticks, and the pulse channels are
+    // clocked every 4 ticks. Only the clock which overflows a channel's period
+    // divider changes its output.
+    if (gscaCheckBit(apu->hot.enable, GSCA_AC_WAVE))
+    {
+        edge = (2 - (ticks & 0b1)) + 2 * (gscaPeriodSteps(apu->wave.periodDivider) - 1);
+        if (edge < cycles) { cycles = edge; }
+    }
+
+    for (gscaEnum i = GSCA_AC_PULSE1; i <= GSCA_AC_PULSE2; ++i)
+    {
+        if (gscaCheckBit(apu->hot.enable, i))
+        {
+            edge = (4 - (ticks & 0b11)) + 4 * (gscaPeriodSteps(apu->pulse[i].periodDivider) - 1);
+            if (edge < cycles) { cycles = edge; }
+        }
+    }
+
+    // Every clock of the noise channel shifts its LFSR, but only the clock
+    // which ends a run of identical output bits changes its output.
+    if (gscaCheckBit(apu->hot.enable, GSCA_AC_NOISE))
+    {
+        const uint32_t frequency = apu->hot.noiseFrequency;
+        edge = frequency - (ticks % frequency) +
+            frequency * gscaCountQuietNoiseClocks(apu);
+        if (edge < cycles) { cycles = edge; }
+    }
+
+    return cycles;
+}
+
+void gscaSkipCycles (gscaAPU* apu, uint32_t cycles)
+{
+    // The caller guarantees that no edge falls within the skipped cycles, so
+    // the only state which changes is the tick counter, the period dividers
+    // of the enabled wave and pulse channels, and the noise channel's LFSR.
+    const uint32_t from = apu->ticks;
+    const uint32_t to = from + cycles;
+
+    if (gscaCheckBit(apu->hot.enable, GSCA_AC_WAVE))
+        { apu->wave.periodDivider += (to >> 1) - (from >> 1); }
+    for (gscaEnum i = GSCA_AC_PULSE1; i <= GSCA_AC_PULSE2; ++i)
+    {
+        if (gscaCheckBit(apu->hot.enable, i))
+            { apu->pulse[i].periodDivider += (to >> 2) - (from >> 2); }
+    }
+    if (gscaCheckBit(apu->hot.enable, GSCA_AC_NOISE))
+    {
+        gscaAdvanceNoiseLFSR(&apu->noise, (to / apu->hot.noiseFrequency) -
+            (from / apu->hot.noiseFrequency));
+    }
+
+    apu->ticks = to;
+}
+
+void gscaAdvancePulseChannel (gscaAPU* apu, gscaEnum channel, uint32_t clocks)
+{
+    gscaPulseChannel* chan = &apu->pulse[channel];
+    uint32_t steps = gscaPeriodSteps(chan->periodDivider);
+    if (clocks < steps)
+    {
+        chan->periodDivider += clocks;
+        return;
+    }
+
+    // After its first overflow, the period divider overflows once every
+    // `$801 - period` clocks.
+    clocks -= steps;
+    uint32_t length = 0x801 - chan->period;
+    chan->periodDivider = chan->period + (clocks % length);
+    chan->wavePointer = (chan->wavePointer + 1 + (clocks / length)) & 0b111;
+    gscaSetDACInput(apu, channel,
+        ((apu->hot.dutyPattern[channel] >> chan->wavePointer) & 0b1) * chan->volume);
+}
+
+void gscaAdvanceWaveChannel (gscaAPU* apu, uint32_t clocks)
+{
+    gscaWaveChannel* chan = &apu->wave;
+    uint32_t steps = gscaPeriodSteps(chan->periodDivider);
+    if (clocks < steps)
+    {
+        chan->periodDivider += clocks;
+        return;
+    }
+
+    clocks -= steps;
+    uint32_t length = 0x801 - chan->period;
+    chan->periodDivider = chan->period + (clocks % length);
+    chan->sampleIndex = (chan->sampleIndex + 1 + (clocks / length)) & 0b11111;
+    gscaSetDACInput(apu, GSCA_AC_WAVE,
+        apu->waveMemory[chan->sampleIndex] >> apu->hot.waveShift);
+}
+
+void gscaAdvanceChannels (gscaAPU* apu, uint32_t cycles)
+{
+    // Unlike `gscaSkipCycles`, any number of the channels' clocks may fall
+    // within the given cycles, but no frame sequencer step may. Each channel
+    // ends up as it would after its last clock.
+    const uint64_t from = apu->ticks;
+    const uint64_t to = from + cycles;
+
+    if (gscaCheckBit(apu->hot.enable, GSCA_AC_WAVE))
+        { gscaAdvanceWaveChannel(apu, (to >> 1) - (from >> 1)); }
+    for (gscaEnum i = GSCA_AC_PULSE1; i <= GSCA_AC_PULSE2; ++i)
+    {
+        if (gscaCheckBit(apu->hot.enable, i))
+            { gscaAdvancePulseChannel(apu, i, (to >> 2) - (from >> 2)); }
+    }
+    if (gscaCheckBit(apu->hot.enable, GSCA_AC_NOISE))
+    {
+        // The tick counter wraps around to zero, which always clocks the noise
+        // channel, whether or not its clock frequency divides `2^32`.
+        const uint32_t frequency = apu->hot.noiseFrequency;
+        uint32_t clocks = (to <= UINT32_MAX) ? (to / frequency) - (from / frequency) :
+            (UINT32_MAX / frequency) - (from / frequency) + 1;
+        if (clocks > 0 && apu->noise.lfsrShort != apu->hot.noiseShort)
+            { gscaTickNoiseChannel(apu); clocks--; }
+        if (clocks > 0)
+        {
+            gscaAdvanceNoiseLFSR(&apu->noise, clocks - 1);
+            gscaTickNoiseChannel(apu);
+        }
+    }
+
+    apu->ticks = (uint32_t) to;
+}
+
+void gscaEmitSample (gscaAPU* apu, void* out, gscaAudioSample* const* stems,
+    size_t frame, gscaSampleFormat format)
+{
+    switch (format)
+    {
+        case GSCA_SF_F32:
+            gscaUpdateAudioSample(apu);
+            if (out != NULL)
+                { ((gscaAudioSample*) out)[frame] = apu->currentSample; }
+            break;
+        case GSCA_SF_S16:
+        {
+            // Full scale is `±1.0` in the floating-point pipeline, which is
+            // `±480` 120ths after its final division by 4.
+            gscaUpdateAudioLevels(apu);
+            int32_t left = apu->currentLevelLeft / 960;
+            int32_t right = apu->currentLevelRight / 960;
+            ((gscaAudioSampleS16*) out)[frame] = (gscaAudioSampleS16) {
+                .left  = (int16_t) ((left  < INT16_MIN) ? INT16_MIN :
+                                    (left  > INT16_MAX) ? INT16_MAX : left),
+                .right = (int16_t) ((right < INT16_MIN) ? INT16_MIN :
+                                    (right > INT16_MAX) ? INT16_MAX : right)
+            };
+        } break;
+        case GSCA_SF_S32:
+        {
+            gscaUpdateAudioLevels(apu);
+            int64_t left = (int64_t) apu->currentLevelLeft * 1024 / 15;
+            int64_t right = (int64_t) apu->currentLevelRight * 1024 / 15;
+            ((gscaAudioSampleS32*) out)[frame] = (gscaAudioSampleS32) {
+                .left  = (int32_t) ((left  < INT32_MIN) ? INT32_MIN :
+                                    (left  > INT32_MAX) ? INT32_MAX : left),
+                .right = (int32_t) ((right < INT32_MIN) ? INT32_MIN :
+                                    (right > INT32_MAX) ? INT32_MAX : right)
+            };
+        } break;
+    }
+    if (stems != NULL)
+        { gscaUpdateStemSamples(apu, stems, frame); }
+}
+
+bool gscaIsAPUSilent (const gscaAPU* apu)
+{
+    // With every channel disabled, no channel is clocked, the frame sequencer
+    // has nothing to clock, and the mixed output is silent.
+    return apu->hot.enable == 0;
+}
+
+void gscaSkipSilentFrames (gscaAPU* apu, size_t frameCount)
+{
+    // Advance the sample clock past the given number of output samples, and
+    // the tick counter and the frame sequencer's step counter with it.
+    uint64_t phase = (uint64_t) frameCount * GSCA_CLOCK_RATE - apu->samplePhase;
+    uint64_t cycles = (phase + apu->sampleRate - 1) / apu->sampleRate;
+    uint64_t to = (uint64_t) apu->ticks + cycles;
+
+    apu->samplePhase = (uint32_t) (cycles * apu->sampleRate - phase);
+    apu->divider += (uint16_t) ((to >> 13) - (apu->ticks >> 13));
+    apu->tickEpoch += (uint32_t) (to >> 32);
+    apu->ticks = (uint32_t) to;
+}
+
+size_t gscaRenderSilence (gscaAPU* apu, void* out, gscaAudioSample* const* stems,
+    size_t frames, size_t frameCount, gscaSampleFormat format)
+{
+    // While the APU is silent, only the high-pass filters (and the band-limited
+    // output stage) still change the output, so jump straight from one output
+    // sample to the next. The filters decay towards a fixed point, which they
+    // reach in finite precision. From then on, every sample is the same, so
+    // the rest of the buffer is filled with copies of the last one.
+    const size_t FIRST = offsetof(gscaAPU, currentSample);
+    const size_t LAST = offsetof(gscaAPU, previousOutputRight) + sizeof(int32_t);
+    uint8_t state[LAST - FIRST];
+    size_t quietFrames = 0;
+
+    while (frames < frameCount)
+    {
+        memcpy(state, (uint8_t*) apu + FIRST, LAST - FIRST);
+        gscaSkipSilentFrames(apu, 1);
+        gscaEmitSample(apu, out, stems, frames++, format);
+
+        // The band-limited output stage's buffer is drained once its last
+        // kernel has been read out.
+        if (memcmp(state, (uint8_t*) apu + FIRST, LAST - FIRST) != 0)
+            { quietFrames = 0; }
+        else if (apu->blip == NULL || ++quietFrames >= GSCA_BLIP_TAPS)
+            { break; }
+    }
+
+    if (frames < frameCount)
+    {
+        gscaSkipSilentFrames(apu, frameCount - frames);
+        size_t size = (format == GSCA_SF_S16) ? sizeof(gscaAudioSampleS16) :
+                      (format == GSCA_SF_S32) ? sizeof(gscaAudioSampleS32) :
+                                                sizeof(gscaAudioSample);
+        for (; frames < frameCount; ++frames)
+        {
+            if (out != NULL)
+                { memcpy((uint8_t*) out + frames * size, (uint8_t*) out + (frames - 1) * size, size); }
+            for (size_t i = 0; stems != NULL && i < GSCA_AUDIO_CHANNEL_COUNT; ++i)
+                { if (stems[i] != NULL) { stems[i][frames] = stems[i][frames - 1]; } }
+        }
+    }
+
+    return frames;
+}
+
+size_t gscaRenderExact (gscaAPU* apu, void* out, gscaAudioSample* const* stems,
+    size_t frameCount, uint64_t cycleLimit, gscaSampleFormat format)
+{
+    // Rather than stepping through every clock cycle, jump straight to the
+    // next cycle on which something can change: a period divider overflow, a
+    // noise clock, a frame sequencer step or an output sample. The cycles in
+    // between are skipped in bulk, and the edge itself is stepped through
+    // exactly as `gscaTickAPU` would, so the output is identical.
+    const uint32_t sampleRate = apu->sampleRate;
+    size_t frames = 0;
+
+    // Register writes made since the last call may have changed the output
+    // level. With the band-limited output stage enabled, step through the
+    // first cycle on its own so that such a change is timestamped there.
+    bool levelDirty = (apu->blip != NULL);
+
+    while (frames < frameCount && cycleLimit > 0)
+    {
+        // While silent, skip ahead by whole output samples, as many as are due
+        // within the cycle limit. Any cycles left over are stepped through as
+        // normal, below.
+        if (!levelDirty && gscaIsAPUSilent(apu))
+        {
+            size_t silentFrames = frameCount;
+            if (cycleLimit < UINT32_MAX)
+            {
+                uint64_t dueFrames =
+                    (cycleLimit * sampleRate + apu->samplePhase) / GSCA_CLOCK_RATE;
+                if (frames + dueFrames < frameCount) { silentFrames = frames + dueFrames; }
+            }
+
+            if (silentFrames > frames)
+            {
+                uint64_t from = gscaGetAPUCycles(apu);
+                frames = gscaRenderSilence(apu, out, stems, frames, silentFrames, format);
+                cycleLimit -= gscaGetAPUCycles(apu) - from;
+                continue;
+            }
+        }
+
+        uint32_t cycles = (levelDirty) ? 1 : gscaCyclesToNextEdge(apu);
+        uint32_t sampleCycles =
+            (GSCA_CLOCK_RATE - apu->samplePhase + sampleRate - 1) / sampleRate;
+        if (sampleCycles < cycles) { cycles = sampleCycles; }
+        if (cycleLimit < cycles) { cycles = (uint32_t) cycleLimit; }
+        cycleLimit -= cycles;
+        levelDirty = false;
+
+        gscaSkipCycles(apu, cycles - 1);
+        gscaStepAPU(apu);
+
+        apu->samplePhase += cycles * sampleRate;
+        if (apu->samplePhase >= GSCA_CLOCK_RATE)
+        {
+            apu->samplePhase -= GSCA_CLOCK_RATE;
+            gscaEmitSample(apu, out, stems, frames, format);
+            frames++;
+        }
+
+        if (apu->blip != NULL)
+            { gscaAddBlipDelta(apu); }
+    }
+
+    return frames;
+}
+
+size_t gscaRenderCoarse (gscaAPU* apu, void* out, gscaAudioSample* const* stems,
+    size_t frameCount, uint64_t cycleLimit, gscaSampleFormat format)
+{
+    // Advance the channels from one output sample straight to the next, however
+    // many of their clocks fall in between. Only the frame sequencer's steps
+    // split the interval, so that its length, sweep and envelope units still
+    // act on the cycle they are due.
+    const uint32_t sampleRate = apu->sampleRate;
+    size_t frames = 0;
+
+    while (frames < frameCount && cycleLimit > 0)
+    {
+        if (gscaIsAPUSilent(apu))
+        {
+            size_t silentFrames = frameCount;
+            if (cycleLimit < UINT32_MAX)
+            {
+                uint64_t dueFrames =
+                    (cycleLimit * sampleRate + apu->samplePhase) / GSCA_CLOCK_RATE;
+                if (frames + dueFrames < frameCount) { silentFrames = frames + dueFrames; }
+            }
+
+            if (silentFrames > frames)
+            {
+                uint64_t from = gscaGetAPUCycles(apu);
+                frames = gscaRenderSilence(apu, out, stems, frames, silentFrames, format);
+                cycleLimit -= gscaGetAPUCycles(apu) - from;
+                continue;
+            }
+        }
+
+        uint32_t cycles = 0x2000 - (apu->ticks & 0x1FFF);
+        uint32_t sampleCycles =
+            (GSCA_CLOCK_RATE - apu->samplePhase + sampleRate - 1) / sampleRate;
+        if (sampleCycles < cycles) { cycles = sampleCycles; }
+        if (cycleLimit < cycles) { cycles = (uint32_t) cycleLimit; }
+        cycleLimit -= cycles;
+
+        gscaAdvanceChannels(apu, cycles);
+        if ((apu->ticks & 0x1FFF) == 0)
+            { gscaTickFrameSequencer(apu); }
+
+        apu->samplePhase += cycles * sampleRate;
+        if (apu->samplePhase >= GSCA_CLOCK_RATE)
+        {
+            apu->samplePhase -= GSCA_CLOCK_RATE;
+            gscaEmitSample(apu, out, stems, frames, format);
+            frames++;
+        }
+
+        if (apu->blip != NULL)
+            { gscaAddBlipDelta(apu); }
+    }
+
+    return frames;
+}
+
+size_t gscaRenderSamples (gscaAPU* apu, void* out, gscaAudioSample* const* stems,
+    size_t frameCount, uint64_t cycleLimit, gscaSampleFormat format)
+{
+    size_t frames = apu->renderKernel(apu, out, stems, frameCount, cycleLimit, format);
+
+    if (format == GSCA_SF_F32 && apu->filter.stageCount > 0)
+    {
+        if (out != NULL)
+            { gscaApplyFilterChain(&apu->filter, 0, out, frames); }
+        for (size_t i = 0; stems != NULL && i < GSCA_AUDIO_CHANNEL_COUNT; ++i)
+        {
+            if (stems[i] != NULL)
+                { gscaApplyFilterChain(&apu->filter, i + 1, stems[i], frames); }
+        }
+    }
+
+    return frames;
+}
+
+bool gscaAnyLane (const gscaLaneU16* mask)
+{
+    uint64_t words[sizeof(gscaLaneU16) / sizeof(uint64_t)], any = 0;
+    memcpy(words, mask, sizeof(gscaLaneU16));
+    for (size_t i = 0; i < sizeof(gscaLaneU16) / sizeof(uint64_t); ++i)
+        { any |= words[i]; }
+
+    return any != 0;
+}
+
+int32_t gscaMinLane (const gscaLaneI32* lanes)
+{
+    int32_t min = INT32_MAX;
+    for (size_t i = 0; i < GSCA_APU_BATCH_LANES; ++i)
+        { if ((*lanes)[i] < min) { min = (*lanes)[i]; } }
+
+    return min;
+}
+
+void gscaMinLanes (gscaLaneI32* a, const gscaLaneI32* b)
+{
+    gscaLaneI32 less = (*b < *a);
+    *a = (*b & less) | (*a & ~less);
+}
+
+uint32_t gscaCyclesToNextLaneEdge (const gscaAPUBatch* batch,
+    const gscaAPULanes* lanes)
+{
+    // As `gscaCyclesToNextEdge`, but the earliest edge of any lane. Every edge
+    // is less than `0x2000` cycles away, except for the noise channel's, so
+    // the edges are compared as signed integers, and the edges of disabled
+    // channels' lanes are replaced with `INT32_MAX`. Their state is not kept
+    // up to date, so their edges may otherwise lie in the past.
+    const uint32_t ticks = batch->ticks;
+    const gscaLaneI32 never = (gscaLaneI32) {} + INT32_MAX;
+    const gscaLaneI32 one = (gscaLaneI32) {} + 1;
+    gscaLaneI32 edges, steps, enabled, overflowing;
+
+    // The frame sequencer's edge is common to every lane.
+    edges = (gscaLaneI32) {} + (int32_t) (0x2000 - (ticks & 0x1FFF));
+
+    // A period divider at or past `$800` overflows on its next clock, as in
+    // `gscaPeriodSteps`.
+    steps = 0x801 - __builtin_convertvector(lanes->wave.periodDivider, gscaLaneI32);
+    overflowing = (steps < one);
+    steps = (one & overflowing) | (steps & ~overflowing);
+    enabled = GSCA_WIDEN_LANES(lanes->wave.enable);
+    steps = (int32_t) (2 - (ticks & 0b1)) + 2 * (steps - 1);
+    steps = (steps & enabled) | (never & ~enabled);
+    gscaMinLanes(&edges, &steps);
+
+    for (gscaEnum c = GSCA_AC_PULSE1; c <= GSCA_AC_PULSE2; ++c)
+    {
+        const gscaPulseLanes* pulse = &lanes->pulse[c];
+        steps = 0x801 - __builtin_convertvector(pulse->periodDivider, gscaLaneI32);
+        overflowing = (steps < one);
+        steps = (one & overflowing) | (steps & ~overflowing);
+        enabled = GSCA_WIDEN_LANES(pulse->enable);
+        steps = (int32_t) (4 - (ticks & 0b11)) + 4 * (steps - 1);
+        steps = (steps & enabled) | (never & ~enabled);
+        gscaMinLanes(&edges, &steps);
+    }
+
+    enabled = GSCA_WIDEN_LANES(lanes->noise.enable);
+    steps = (gscaLaneI32) (lanes->noise.nextTick - ticks);
+    steps = (steps & enabled) | (never & ~enabled);
+    gscaMinLanes(&edges, &steps);
+
+    return (uint32_t) gscaMinLane(&edges);
+}
+
+void gscaSkipLaneCycles (gscaAPUBatch* batch, gscaAPULanes* lanes,
+    uint32_t cycles)
+{
+    const uint32_t from = batch->ticks;
+    const uint32_t to = from + cycles;
+    const uint16_t waveTicks = (to >> 1) - (from >> 1);
+    const uint16_t pulseTicks = (to >> 2) - (from >> 2);
+
+    lanes->wave.periodDivider += lanes->wave.enable & waveTicks;
+    for (gscaEnum c = GSCA_AC_PULSE1; c <= GSCA_AC_PULSE2; ++c)
+        { lanes->pulse[c].periodDivider += lanes->pulse[c].enable & pulseTicks; }
+    batch->ticks = to;
+}
+
+void gscaGatherAPULanes (const gscaAPUBatch* batch, gscaAPULanes* lanes)
+{
+    gscaZero(lanes, 1, gscaAPULanes);
+    for (size_t i = 0; i < batch->laneCount; ++i)
+    {
+        const gscaAPU* apu = batch->lanes[i];
+        const gscaHotState* hot = &apu->hot;
+        const uint8_t on = hot->enable & hot->dacEnable;
+        const uint8_t left = on & hot->panLeft, right = on & hot->panRight;
+
+        for (gscaEnum c = GSCA_AC_PULSE1; c <= GSCA_AC_PULSE2; ++c)
+        {
+            gscaPulseLanes* pulse = &lanes->pulse[c];
+            pulse->enable[i] = gscaCheckBit(hot->enable, c) ? 0xFFFF : 0;
+            pulse->period[i] = apu->pulse[c].period;
+            pulse->periodDivider[i] = apu->pulse[c].periodDivider;
+            pulse->wavePointer[i] = apu->pulse[c].wavePointer;
+            pulse->dutyPattern[i] = hot->dutyPattern[c];
+            pulse->volume[i] = apu->pulse[c].volume;
+            pulse->dacInput[i] = hot->dacInput[c];
+            pulse->dacOutput[i] = hot->dacOutput[c];
+            pulse->mixLeft[i] = gscaCheckBit(left, c) ? -1 : 0;
+            pulse->mixRight[i] = gscaCheckBit(right, c) ? -1 : 0;
+        }
+
+        gscaWaveLanes* wave = &lanes->wave;
+        wave->enable[i] = gscaCheckBit(hot->enable, GSCA_AC_WAVE) ? 0xFFFF : 0;
+        wave->period[i] = apu->wave.period;
+        wave->periodDivider[i] = apu->wave.periodDivider;
+        wave->sampleIndex[i] = apu->wave.sampleIndex;
+        wave->outputShift[i] = hot->waveShift;
+        wave->dacInput[i] = hot->dacInput[GSCA_AC_WAVE];
+        wave->dacOutput[i] = hot->dacOutput[GSCA_AC_WAVE];
+        wave->mixLeft[i] = gscaCheckBit(left, GSCA_AC_WAVE) ? -1 : 0;
+        wave->mixRight[i] = gscaCheckBit(right, GSCA_AC_WAVE) ? -1 : 0;
+
+        // The noise channel is clocked whenever the tick counter is a multiple
+        // of its clock frequency, so track the next such tick.
+        gscaNoiseLanes* noise = &lanes->noise;
+        uint32_t clockFrequency = hot->noiseFrequency;
+        noise->enable[i] = gscaCheckBit(hot->enable, GSCA_AC_NOISE) ? 0xFFFF : 0;
+        noise->clockFrequency[i] = clockFrequency;
+        noise->nextTick[i] =
+            batch->ticks + (clockFrequency - (batch->ticks % clockFrequency));
+        noise->lfsr[i] = gscaGetNoiseLFSR(&apu->noise);
+        noise->widthMask[i] = (hot->noiseShort) ? 0xFFFF : 0;
+        noise->volume[i] = apu->noise.volume;
+        noise->dacInput[i] = hot->dacInput[GSCA_AC_NOISE];
+        noise->dacOutput[i] = hot->dacOutput[GSCA_AC_NOISE];
+        noise->mixLeft[i] = gscaCheckBit(left, GSCA_AC_NOISE) ? -1 : 0;
+        noise->mixRight[i] = gscaCheckBit(right, GSCA_AC_NOISE) ? -1 : 0;
+
+        lanes->volumeLeft[i] = hot->volumeLeft;
+        lanes->volumeRight[i] = hot->volumeRight;
+        lanes->previousInputLeft[i] = apu->previousInput.left;
+        lanes->previousInputRight[i] = apu->previousInput.right;
+        lanes->previousOutputLeft[i] = apu->previousOutput.left;
+        lanes->previousOutputRight[i] = apu->previousOutput.right;
+        lanes->currentLeft[i] = apu->currentSample.left;
+        lanes->currentRight[i] = apu->currentSample.right;
+    }
+}
+
+void gscaScatterAPULanes (gscaAPUBatch* batch, const gscaAPULanes* lanes)
+{
+    for (size_t i = 0; i < batch->laneCount; ++i)
+    {
+        gscaAPU* apu = batch->lanes[i];
+        apu->ticks = batch->ticks;
+        apu->samplePhase = batch->samplePhase;
+
+        for (gscaEnum c = GSCA_AC_PULSE1; c <= GSCA_AC_PULSE2; ++c)
+        {
+            apu->pulse[c].periodDivider = lanes->pulse[c].periodDivider[i];
+            apu->pulse[c].wavePointer = lanes->pulse[c].wavePointer[i];
+            apu->hot.dacInput[c] = lanes->pulse[c].dacInput[i];
+            apu->hot.dacOutput[c] = lanes->pulse[c].dacOutput[i];
+        }
+
+        apu->wave.periodDivider = lanes->wave.periodDivider[i];
+        apu->wave.sampleIndex = lanes->wave.sampleIndex[i];
+        apu->hot.dacInput[GSCA_AC_WAVE] = lanes->wave.dacInput[i];
+        apu->hot.dacOutput[GSCA_AC_WAVE] = lanes->wave.dacOutput[i];
+
+        if (lanes->noise.lfsr[i] != gscaGetNoiseLFSR(&apu->noise))
+            { gscaSetNoiseLFSR(&apu->noise, lanes->noise.lfsr[i], apu->hot.noiseShort); }
+        apu->hot.dacInput[GSCA_AC_NOISE] = lanes->noise.dacInput[i];
+        apu->hot.dacOutput[GSCA_AC_NOISE] = lanes->noise.dacOutput[i];
+
+        for (gscaEnum c = 0; c < GSCA_AUDIO_CHANNEL_COUNT; ++c)
+            { apu->hot.dacLevel[c] = GSCA_DAC_LEVEL(apu->hot.dacInput[c]); }
+
+        apu->previousInput.left = lanes->previousInputLeft[i];
+        apu->previousInput.right = lanes->previousInputRight[i];
+        apu->previousOutput.left = lanes->previousOutputLeft[i];
+        apu->previousOutput.right = lanes->previousOutputRight[i];
+        apu->currentSample.left = lanes->currentLeft[i];
+        apu->currentSample.right = lanes->currentRight[i];
+    }
+}
+
+void gscaTickPulseLanes (gscaPulseLanes* pulse)
+{
+    pulse->periodDivider += pulse->enable & 1;
+    gscaLaneU16 overflow =
+        (gscaLaneU16) (pulse->periodDivider > 0x800) & pulse->enable;
+    if (!gscaAnyLane(&overflow)) { return; }
+
+    pulse->periodDivider =
+        (pulse->period & overflow) | (pulse->periodDivider & ~overflow);
+    pulse->wavePointer = (pulse->wavePointer + (overflow & 1)) & 0b111;
+
+    gscaLaneU16 dacInput =
+        ((pulse->dutyPattern >> pulse->wavePointer) & 0b1) * pulse->volume;
+    pulse->dacInput = (dacInput & overflow) | (pulse->dacInput & ~overflow);
+    pulse->dacOutput = GSCA_SELECT_LANES(GSCA_WIDEN_LANES(overflow),
+        GSCA_DAC_OUTPUT_LANES(dacInput), pulse->dacOutput);
+}
+
+void gscaTickWaveLanes (const gscaAPUBatch* batch, gscaWaveLanes* wave)
+{
+    wave->periodDivider += wave->enable & 1;
+    gscaLaneU16 overflow =
+        (gscaLaneU16) (wave->periodDivider > 0x800) & wave->enable;
+    if (!gscaAnyLane(&overflow)) { return; }
+
+    wave->periodDivider =
+        (wave->period & overflow) | (wave->periodDivider & ~overflow);
+    wave->sampleIndex = (wave->sampleIndex + (overflow & 1)) & 0b11111;
+
+    // Each lane reads from its own wave memory, which cannot be gathered into
+    // a vector.
+    for (size_t i = 0; i < batch->laneCount; ++i)
+    {
+        if (overflow[i])
+        {
+            wave->dacInput[i] = batch->lanes[i]->waveMemory[wave->sampleIndex[i]]
+                >> wave->outputShift[i];
+        }
+    }
+
+    wave->dacOutput = GSCA_SELECT_LANES(GSCA_WIDEN_LANES(overflow),
+        GSCA_DAC_OUTPUT_LANES(wave->dacInput), wave->dacOutput);
+}
+
+void gscaTickNoiseLanes (gscaNoiseLanes* noise, uint32_t ticks)
+{
+    // A wrap of the tick counter lands on a multiple of every frequency.
+    gscaLaneU32 due = (gscaLaneU32) (noise->nextTick == ticks);
+    if (ticks == 0) { due = ~(gscaLaneU32) {}; }
+    noise->nextTick = ((ticks + noise->clockFrequency) & due) |
+        (noise->nextTick & ~due);
+
+    gscaLaneU16 clocked = (gscaLaneU16) __builtin_convertvector(
+        (gscaLaneI32) due, gscaLaneI16) & noise->enable;
+    if (!gscaAnyLane(&clocked)) { return; }
+
+    gscaLaneU16 lfsr = noise->lfsr;
+    gscaLaneU16 bit = ((lfsr ^ (lfsr >> 1)) & 0b1) ^ 0b1;
+    lfsr |= (bit << 15) | ((bit << 7) & noise->widthMask);
+    lfsr >>= 1;
+    lfsr &= ~(0x80 & noise->widthMask);
+
+    gscaLaneU16 dacInput = bit * noise->volume;
+    noise->lfsr = (lfsr & clocked) | (noise->lfsr & ~clocked);
+    noise->dacInput = (dacInput & clocked) | (noise->dacInput & ~clocked);
+    noise->dacOutput = GSCA_SELECT_LANES(GSCA_WIDEN_LANES(clocked),
+        GSCA_DAC_OUTPUT_LANES(dacInput), noise->dacOutput);
+}
+
+void gscaMixAPULanes (gscaAPULanes* lanes)
+{
+    static const float HPF_ALPHA = 0.999958f;
+    static const gscaLaneF32 ZERO = {};
+
+    // Channels are summed in the same order as `gscaMixAudioSample`, so that
+    // each lane's output is bit-identical to a scalar APU's.
+    gscaLaneF32 left = ZERO, right = ZERO;
+    left  += GSCA_SELECT_LANES(lanes->pulse[0].mixLeft, lanes->pulse[0].dacOutput, ZERO);
+    right += GSCA_SELECT_LANES(lanes->pulse[0].mixRight, lanes->pulse[0].dacOutput, ZERO);
+    left  += GSCA_SELECT_LANES(lanes->pulse[1].mixLeft,  lanes->pulse[1].dacOutput, ZERO);
+    right += GSCA_SELECT_LANES(lanes->pulse[1].mixRight, lanes->pulse[1].dacOutput, ZERO);
+    left  += GSCA_SELECT_LANES(lanes->wave.mixLeft,     lanes->wave.dacOutput,    ZERO);
+    right += GSCA_SELECT_LANES(lanes->wave.mixRight,    lanes->wave.dacOutput,    ZERO);
+    left  += GSCA_SELECT_LANES(lanes->noise.mixLeft,    lanes->noise.dacOutput,   ZERO);
+    right += GSCA_SELECT_LANES(lanes->noise.mixRight,   lanes->noise.dacOutput,   ZERO);
+    left  *= lanes->volumeLeft;
+    right *= lanes->volumeRight;
+
+    gscaLaneF32 newLeft =
+        left - lanes->previousInputLeft + HPF_ALPHA * lanes->previousOutputLeft;
+    gscaLaneF32 newRight =
+        right - lanes->previousInputRight + HPF_ALPHA * lanes->previousOutputRight;
+    lanes->previousInputLeft = left;
+    lanes->previousInputRight = right;
+    lanes->previousOutputLeft = newLeft;
+    lanes->previousOutputRight = newRight;
+    lanes->currentLeft = newLeft / 4.0f;
+    lanes->currentRight = newRight / 4.0f;
+}
+
+void gscaConvertSamples (gscaAPU* apu, const gscaOutputFormat* format, void* const* out,
+    size_t offset, const gscaAudioSample* samples, size_t count)
+{
+    static const gscaLaneF32 ZERO = {};
+
+    // The samples are converted a vector at a time, as a flat array of
+    // alternating left and right values, so that each lane's channel follows
+    // from its index.
+    const float* in = (const float*) samples;
+    const size_t length = count * 2;
+    const bool planar = (format->layout == GSCA_SL_PLANAR);
+    float scale = 1.0f, low = 0.0f, high = 0.0f;
+
+    switch (format->type)
+    {
+        case GSCA_ST_S16:   scale = 32767.0f;   low = -32768.0f;    high = 32767.0f;    break;
+        case GSCA_ST_S24:   scale = 8388607.0f; low = -8388608.0f;  high = 8388607.0f;  break;
+        case GSCA_ST_U8:    scale = 127.0f;     low = -128.0f;      high = 127.0f;      break;
+        default: break;
+    }
+
+    gscaLaneU32 state;
+    memcpy(&state, apu->ditherState, sizeof(state));
+
+    for (size_t i = 0; i < length; i += GSCA_APU_BATCH_LANES)
+    {
+        size_t lanes = (length - i < GSCA_APU_BATCH_LANES) ? (length - i) : GSCA_APU_BATCH_LANES;
+        gscaLaneF32 x = ZERO;
+        memcpy(&x, in + i, lanes * sizeof(float));
+
+        if (format->type == GSCA_ST_F32)
+        {
+            if (planar == false)
+            {
+                memcpy((float*) out[0] + offset * 2 + i, &x, lanes * sizeof(float));
+                continue;
+            }
+
+            for (size_t j = 0; j < lanes; ++j)
+                { ((float*) out[(i + j) & 1])[offset + (i + j) / 2] = x[j]; }
+            continue;
+        }
+
+        x *= scale;
+        if (format->dither == true)
+        {
+            // Triangular dither of up to one step either way, from the
+            // difference of two uniform draws from each lane's generator.
+            state = state * 1664525u + 1013904223u;
+            gscaLaneF32 a = __builtin_convertvector(state >> 8, gscaLaneF32);
+            state = state * 1664525u + 1013904223u;
+            gscaLaneF32 b = __builtin_convertvector(state >> 8, gscaLaneF32);
+            x += (a - b) * (1.0f / 16777216.0f);
+        }
+
+        // Round half away from zero, then clamp, so that the conversion's
+        // truncation lands on the nearest value in range.
+        x += GSCA_SELECT_LANES(x < 0.0f, ZERO - 0.5f, ZERO + 0.5f);
+        x = GSCA_SELECT_LANES(x < low, ZERO + low, x);
+        x = GSCA_SELECT_LANES(x > high, ZERO + high, x);
+        gscaLaneI32 y = __builtin_convertvector(x, gscaLaneI32);
+
+        if (format->type == GSCA_ST_S16 && planar == false)
+        {
+            gscaLaneI16 narrow = __builtin_convertvector(y, gscaLaneI16);
+            memcpy((int16_t*) out[0] + offset * 2 + i, &narrow, lanes * sizeof(int16_t));
+            continue;
+        }
+
+        for (size_t j = 0; j < lanes; ++j)
+        {
+            size_t index = (planar) ? (offset + (i + j) / 2) : (offset * 2 + i + j);
+            uint8_t* dest = out[(planar) ? ((i + j) & 1) : 0];
+            switch (format->type)
+            {
+                case GSCA_ST_S16:
+                    ((int16_t*) dest)[index] = (int16_t) y[j];
+                    break;
+                case GSCA_ST_S24:
+                    dest[index * 3 + 0] = (uint8_t) (y[j] & 0xFF);
+                    dest[index * 3 + 1] = (uint8_t) ((y[j] >> 8) & 0xFF);
+                    dest[index * 3 + 2] = (uint8_t) ((y[j] >> 16) & 0xFF);
+                    break;
+                case GSCA_ST_U8:
+                    dest[index] = (uint8_t) (y[j] + 128);
+                    break;
+                default: break;
+            }
+        }
+    }
+
+    memcpy(apu->ditherState, &state, sizeof(state));
+}
+
+size_t gscaRenderFormatted (gscaAPU* apu, const gscaOutputFormat* format, void* const* out,
+    size_t frameCount, uint64_t cycleLimit)
+{
+    // Render a block at a time into a buffer small enough to stay in cache,
+    // and convert each block from there.
+    gscaAudioSample block[GSCA_CONVERT_BLOCK_SIZE];
+    uint64_t start = gscaGetAPUCycles(apu);
+    size_t frames = 0;
+
+    while (frames < frameCount && gscaGetAPUCycles(apu) - start < cycleLimit)
+    {
+        size_t count = frameCount - frames;
+        if (count > GSCA_CONVERT_BLOCK_SIZE) { count = GSCA_CONVERT_BLOCK_SIZE; }
+
+        count = gscaRenderSamples(apu, block, NULL, count,
+            cycleLimit - (gscaGetAPUCycles(apu) - start), GSCA_SF_F32);
+        gscaConvertSamples(apu, format, out, frames, block, count);
+        frames += count;
+    }
+
+    return frames;
+}
+
+/* Public Functions ***********************************************************/
+
+gscaAPU* gscaCreateAPU (gscaAccuracy accuracy)
+{
+    // The APU's hot channel state is aligned to a cache line, which `calloc`
+    // does not guarantee.
+    gscaAPU* apu = gscaCreateAligned(1, gscaAPU);
+    gscaExpectp(apu, "Cannot create APU context");
+    gscaZero(apu, 1, gscaAPU);
+
+    // The render kernel is chosen once, here, rather than on every call.
+    switch (accuracy)
+    {
+        case GSCA_ACC_PREVIEW:  apu->renderKernel = gscaRenderCoarse; break;
+        default:                apu->renderKernel = gscaRenderExact; break;
+    }
+    apu->accuracy = accuracy;
+
+    gscaInitNoiseTables();
+    gscaResetAPU(apu);
+    return apu;
+}
+
+void gscaResetAPU (gscaAPU* apu)
+{
+    gscaExpect(apu, "Pointer 'apu' is NULL.\n");
+    gscaBlipBuffer* blip = apu->blip;
+    gscaRegisterLog* regLog = apu->regLog;
+    const uint8_t (*waveBank)[GSCA_WAVE_RAM_SIZE] = apu->waveBank;
+    size_t waveBankSize = apu->waveBankSize;
+    gscaRenderKernel renderKernel = apu->renderKernel;
+    gscaEnum accuracy = apu->accuracy;
+    uint32_t sampleRate = apu->sampleRate;
+    gscaEnum filterModel = apu->filter.model;
+    float lowPassCutoff = apu->filter.lowPassCutoff;
+    uint32_t tapCount = apu->tapCount;
+    uint32_t tapRates[GSCA_APU_MAX_OUTPUT_TAPS];
+    for (uint32_t i = 0; i < GSCA_APU_MAX_OUTPUT_TAPS; ++i)
+        { tapRates[i] = apu->taps[i].sampleRate; }
+    gscaZero(apu, 1, gscaAPU);
+    apu->blip = blip;
+    apu->regLog = regLog;
+    apu->renderKernel = renderKernel;
+    apu->accuracy = accuracy;
+    apu->waveBank = (waveBank != NULL) ? waveBank : GSCA_DEFAULT_WAVE_PATTERNS;
+    apu->waveBankSize = (waveBank != NULL) ? waveBankSize : GSCA_DEFAULT_WAVE_PATTERN_COUNT;
+    apu->sampleRate = (sampleRate != 0) ? sampleRate : GSCA_DEFAULT_SAMPLE_RATE;
+    apu->filter.model = filterModel;
+    apu->filter.lowPassCutoff = lowPassCutoff;
+    gscaInitFilterChain(&apu->filter, apu->sampleRate);
+    apu->tapCount = tapCount;
+    for (uint32_t i = 0; i < tapCount; ++i)
+        { apu->taps[i].sampleRate = tapRates[i]; }
+    gscaInitOutputTaps(apu);
+    for (uint32_t i = 0; i < GSCA_APU_BATCH_LANES; ++i)
+        { apu->ditherState[i] = 0x9E3779B9u * (i + 1); }
+    apu->nr52.value = 0xF0;
+    apu->nr51.value = 0xF3;
+    apu->nr50.value = 0x77;
+    apu->nr10.value = 0x80;
+    apu->nr11.value = 0xBF;
+    apu->nr12.value = 0xF3;
+    apu->nr13.value = 0xFF;
+    apu->nr14.value = 0xBF;
+    apu->nr21.value = 0x3F;
+    apu->nr22.value = 0x00;
+    apu->nr23.value = 0xFF;
+    apu->nr24.value = 0xBF;
+    apu->nr30.value = 0x7F;
+    apu->nr31.value = 0xFF;
+    apu->nr32.value = 0x9F;
+    apu->nr33.value = 0xFF;
+    apu->nr34.value = 0xBF;
+    apu->nr41.value = 0xFF;
+    apu->nr42.value = 0x00;
+    apu->nr43.value = 0x00;
+    apu->nr44.value = 0xBF;
+    apu->hot.enable = GSCA_CHANNEL_BIT(GSCA_AC_PULSE1);
+    gscaDecodeRegisters(apu);
+    gscaUpdateNoiseClockFrequency(apu);
+    if (apu->blip != NULL) { gscaInitBlipBuffer(apu); }
+}
+
+void gscaDestroyAPU (gscaAPU* apu)
+{
+    if (apu != NULL)
+    {
+        gscaDestroy(apu->blip);
+        gscaDestroyAligned(apu);
+    }
+}
+
+void gscaSetBandLimitedOutput (gscaAPU* apu, bool enable)
+{
+    gscaExpect(apu, "Pointer 'apu' is NULL.\n");
+
+    if (enable && apu->blip == NULL)
+    {
+        apu->blip = gscaCreate(1, gscaBlipBuffer);
+        gscaExpectp(apu->blip, "Cannot create band-limited output buffer");
+        gscaInitBlipBuffer(apu);
+    }
+    else if (!enable && apu->blip != NULL)
+    {
+        gscaDestroy(apu->blip);
+    }
+}
+
+bool gscaSetAPUSampleRate (gscaAPU* apu, uint32_t sampleRate)
+{
+    gscaExpect(apu, "Pointer 'apu' is NULL.\n");
+
+    if (sampleRate == 0 || sampleRate > GSCA_CLOCK_RATE)
+    {
+        gscaErr("Sample rate %u Hz is out of range.\n", sampleRate);
+        return false;
+    }
+
+    apu->sampleRate = sampleRate;
+    gscaInitFilterChain(&apu->filter, apu->sampleRate);
+    return true;
+}
+
+uint32_t gscaGetAPUSampleRate (const gscaAPU* apu)
+{
+    gscaExpect(apu, "Pointer 'apu' is NULL.\n");
+    return apu->sampleRate;
+}
+
+void gscaSetAPUFilterModel (gscaAPU* apu, gscaFilterModel model)
+{
+    gscaExpect(apu, "Pointer 'apu' is NULL.\n");
+    apu->filter.model = model;
+    gscaInitFilterChain(&apu->filter, apu->sampleRate);
+    gscaInitOutputTaps(apu);
+}
+
+gscaFilterModel gscaGetAPUFilterModel (const gscaAPU* apu)
+{
+    gscaExpect(apu, "Pointer 'apu' is NULL.\n");
+    return apu->filter.model;
+}
+
+bool gscaSetAPULowPassCutoff (gscaAPU* apu, float cutoff)
+{
+    gscaExpect(apu, "Pointer 'apu' is NULL.\n");
+
+    if (cutoff < 0.0f || cutoff >= apu->sampleRate / 2.0f)
+    {
+        gscaErr("Low-pass cutoff %g Hz is out of range.\n", cutoff);
+        return false;
+    }
+
+    apu->filter.lowPassCutoff = cutoff;
+    gscaInitFilterChain(&apu->filter, apu->sampleRate);
+    gscaInitOutputTaps(apu);
+    return true;
+}
+
+size_t gscaGetAPUStateSize (const gscaAPU* apu)
+{
+    gscaExpect(apu, "Pointer 'apu' is NULL.\n");
+    return sizeof(gscaAPUStateHeader) + sizeof(gscaAPU) +
+        ((apu->blip != NULL) ? GSCA_BLIP_STATE_SIZE : 0);
+}
+
+size_t gscaSaveAPUState (const gscaAPU* apu, void* buffer, size_t size)
+{
+    gscaExpect(apu, "Pointer 'apu' is NULL.\n");
+    gscaExpect(buffer, "Pointer 'buffer' is NULL.\n");
+
+    size_t stateSize = gscaGetAPUStateSize(apu);
+    if (size < stateSize)
+    {
+        gscaErr("Buffer of %zu bytes is too small for an APU state of %zu bytes.\n",
+            size, stateSize);
+        return 0;
+    }
+
+    gscaAPUStateHeader header = {
+        .magicNumber    = GSCA_APU_STATE_MAGIC_NUMBER,
+        .version        = GSCA_APU_STATE_VERSION,
+        .flags          = (apu->blip != NULL) ? GSCA_APU_STATE_BLIP : 0,
+        .apuSize        = sizeof(gscaAPU),
+        .blipSize       = (apu->blip != NULL) ? GSCA_BLIP_STATE_SIZE : 0
+    };
+
+    // The APU's pointers (to the band-limited output stage, the register log
+    // and the wave pattern bank) mean nothing outside of this context, so they
+    // are cleared in the snapshot.
+    uint8_t* data = buffer;
+    gscaAPU state = *apu;
+    state.blip = NULL;
+    state.regLog = NULL;
+    state.waveBank = NULL;
+    state.waveBankSize = 0;
+    state.renderKernel = NULL;
+    memcpy(data, &header, sizeof(header));
+    memcpy(data + sizeof(header), &state, sizeof(gscaAPU));
+    if (apu->blip != NULL)
+    {
+        memcpy(data + sizeof(header) + sizeof(gscaAPU),
+            (const uint8_t*) apu->blip + GSCA_BLIP_STATE_OFFSET, GSCA_BLIP_STATE_SIZE);
+    }
+
+    return stateSize;
+}
+
+bool gscaLoadAPUState (gscaAPU* apu, const void* buffer, size_t size)
+{
+    gscaExpect(apu, "Pointer 'apu' is NULL.\n");
+    gscaExpect(buffer, "Pointer 'buffer' is NULL.\n");
+
+    const uint8_t* data = buffer;
+    gscaAPUStateHeader header;
+    if (size < sizeof(header))
+    {
+        gscaErr("Buffer is too small to hold an APU state header.\n");
+        return false;
+    }
+
+    // Validate header.
+    memcpy(&header, data, sizeof(header));
+    bool hasBlip = (header.flags & GSCA_APU_STATE_BLIP) != 0;
+    if (header.magicNumber != GSCA_APU_STATE_MAGIC_NUMBER)
+    {
+        gscaErr("Provided buffer has incorrect magic number (0x%08X).\n",
+            header.magicNumber);
+        return false;
+    }
+    else if (header.version != GSCA_APU_STATE_VERSION)
+    {
+        gscaErr("Provided buffer has incorrect APU state version (%u).\n",
+            header.version);
+        return false;
+    }
+    else if (
+        header.apuSize != sizeof(gscaAPU) ||
+        header.blipSize != ((hasBlip) ? GSCA_BLIP_STATE_SIZE : 0) ||
+        size < sizeof(header) + header.apuSize + header.blipSize
+    )
+    {
+        gscaErr("Provided buffer has an APU state of the wrong size.\n");
+        return false;
+    }
+
+    // The snapshot also restores whether the band-limited output stage is
+    // enabled. Its kernel is only computed when it is first enabled.
+    gscaSetBandLimitedOutput(apu, hasBlip);
+    gscaBlipBuffer* blip = apu->blip;
+    gscaRegisterLog* regLog = apu->regLog;
+    const uint8_t (*waveBank)[GSCA_WAVE_RAM_SIZE] = apu->waveBank;
+    size_t waveBankSize = apu->waveBankSize;
+    gscaRenderKernel renderKernel = apu->renderKernel;
+    gscaEnum accuracy = apu->accuracy;
+    memcpy(apu, data + sizeof(header), sizeof(gscaAPU));
+    apu->blip = blip;
+    apu->regLog = regLog;
+    apu->waveBank = waveBank;
+    apu->waveBankSize = waveBankSize;
+    apu->renderKernel = renderKernel;
+    apu->accuracy = accuracy;
+    if (hasBlip)
+    {
+        memcpy((uint8_t*) apu->blip + GSCA_BLIP_STATE_OFFSET,
+            data + sizeof(header) + sizeof(gscaAPU), GSCA_BLIP_STATE_SIZE);
+    }
+
+    return true;
+}
+
+const gscaAudioSample* gscaGetCurrentSample (const gscaAPU* apu)
+{
+    gscaExpect(apu, "Pointer 'apu' is NULL.\n");
+    return &apu->currentSample;
+}
+
+bool gscaSetWavePattern (gscaAPU* apu, const char* pattern)
+{
+    gscaExpect(apu, "Pointer 'apu' is NULL.\n");
+    gscaExpect(pattern, "Pointer 'pattern' is NULL.\n");
+
+    if (strlen(pattern) != GSCA_WAVE_RAM_NIBBLE_SIZE)
+    {
+        gscaErr("Wave pattern string must be 32 characters in length.\n");
+        return false;
+    }
+
+    uint8_t waveRAM[GSCA_WAVE_RAM_SIZE] = { 0 };
+    for (int i = 0; i < GSCA_WAVE_RAM_NIBBLE_SIZE; ++i)
+    {
+        char c = pattern[i];
+        if (!isxdigit(c))
+        {
+            gscaErr("Wave pattern character %d ('%c') is not hexadecimal.\n",
+                i, c);
+            return false;
+        }
+
+        uint8_t nibble = isdigit(c) ? (c - '0') : (toupper(c) - 'A' + 10);
+        waveRAM[i / 2] |= (i % 2 == 0) ? (nibble << 4) : nibble;
+    }
+
+    gscaSetWaveRAM(apu, waveRAM);
+    return true;
+}
+
+void gscaSetWaveRAM (gscaAPU* apu, const uint8_t waveRAM[GSCA_WAVE_RAM_SIZE])
+{
+    gscaExpect(apu, "Pointer 'apu' is NULL.\n");
+    gscaExpect(waveRAM, "Pointer 'waveRAM' is NULL.\n");
+
+    for (int i = 0; i < GSCA_WAVE_RAM_SIZE; ++i)
+    {
+        apu->waveMemory[i * 2] = (waveRAM[i] >> 4) & 0xF;
+        apu->waveMemory[i * 2 + 1] = waveRAM[i] & 0xF;
+        gscaLogRegisterWrite(apu, GSCA_AR_WAVE_RAM + i, waveRAM[i]);
+    }
+}
+
+void gscaSetWaveBank (gscaAPU* apu, const uint8_t (*patterns)[GSCA_WAVE_RAM_SIZE],
+    size_t count)
+{
+    gscaExpect(apu, "Pointer 'apu' is NULL.\n");
+
+    if (patterns == NULL || count == 0)
+    {
+        apu->waveBank = GSCA_DEFAULT_WAVE_PATTERNS;
+        apu->waveBankSize = GSCA_DEFAULT_WAVE_PATTERN_COUNT;
+    }
+    else
+    {
+        apu->waveBank = patterns;
+        apu->waveBankSize = count;
+    }
+}
+
+size_t gscaGetWaveBankSize (const gscaAPU* apu)
+{
+    gscaExpect(apu, "Pointer 'apu' is NULL.\n");
+    return apu->waveBankSize;
+}
+
+bool gscaSelectWavePattern (gscaAPU* apu, size_t index)
+{
+    gscaExpect(apu, "Pointer 'apu' is NULL.\n");
+    gscaCheckv(index < apu->waveBankSize, false,
+        "Wave pattern index %zu is out of range.\n", index);
+
+    gscaSetWaveRAM(apu, apu->waveBank[index]);
+    return true;
+}
+
+const uint8_t* gscaGetWavePattern (const gscaAPU* apu, size_t index)
+{
+    gscaExpect(apu, "Pointer 'apu' is NULL.\n");
+    gscaCheckv(index < apu->waveBankSize, NULL,
+        "Wave pattern index %zu is out of range.\n", index);
+
+    return apu->waveBank[index];
+}
+
+uint64_t gscaGetAPUCycles (const gscaAPU* apu)
+{
+    gscaExpect(apu, "Pointer 'apu' is NULL.\n");
+    return ((uint64_t) apu->tickEpoch << 32) | apu->ticks;
+}
+
+void gscaSetAPURegisterLog (gscaAPU* apu, gscaRegisterLog* log)
+{
+    gscaExpect(apu, "Pointer 'apu' is NULL.\n");
+    apu->regLog = log;
+}
+
+bool gscaTickAPU (gscaAPU* apu)
+{
+    gscaExpect(apu, "Pointer 'apu' is NULL.\n");
+
+    gscaStepAPU(apu);
+
+    // The sample clock advances by the sample rate on every cycle, and an
+    // output sample is due each time it passes the APU's clock rate.
+    bool sampleDue = false;
+    apu->samplePhase += apu->sampleRate;
+    if (apu->samplePhase >= GSCA_CLOCK_RATE)
+    {
+        apu->samplePhase -= GSCA_CLOCK_RATE;
+        gscaUpdateAudioSample(apu);
+        if (apu->filter.stageCount > 0)
+            { gscaApplyFilterChain(&apu->filter, 0, &apu->currentSample, 1); }
+        sampleDue = true;
+    }
+
+    if (apu->blip != NULL)
+        { gscaAddBlipDelta(apu); }
+
+    return sampleDue;
+}
+
+size_t gscaRenderAPU (gscaAPU* apu, gscaAudioSample* out, size_t frameCount)
+{
+    gscaExpect(apu, "Pointer 'apu' is NULL.\n");
+    gscaExpect(out != NULL || frameCount == 0, "Pointer 'out' is NULL.\n");
+    return gscaRenderSamples(apu, out, NULL, frameCount, UINT64_MAX, GSCA_SF_F32);
+}
+
+size_t gscaRenderAPUUntil (gscaAPU* apu, gscaAudioSample* out, size_t frameCount,
+    uint64_t cycle)
+{
+    gscaExpect(apu, "Pointer 'apu' is NULL.\n");
+    gscaExpect(out != NULL || frameCount == 0, "Pointer 'out' is NULL.\n");
+
+    uint64_t now = gscaGetAPUCycles(apu);
+    if (cycle <= now) { return 0; }
+
+    return gscaRenderSamples(apu, out, NULL, frameCount, cycle - now, GSCA_SF_F32);
+}
+
+size_t gscaRenderAPUS16 (gscaAPU* apu, gscaAudioSampleS16* out, size_t frameCount)
+{
+    gscaExpect(apu, "Pointer 'apu' is NULL.\n");
+    gscaExpect(out != NULL || frameCount == 0, "Pointer 'out' is NULL.\n");
+    return gscaRenderSamples(apu, out, NULL, frameCount, UINT64_MAX, GSCA_SF_S16);
+}
+
+size_t gscaRenderAPUS32 (gscaAPU* apu, gscaAudioSampleS32* out, size_t frameCount)
+{
+    gscaExpect(apu, "Pointer 'apu' is NULL.\n");
+    gscaExpect(out != NULL || frameCount == 0, "Pointer 'out' is NULL.\n");
+    return gscaRenderSamples(apu, out, NULL, frameCount, UINT64_MAX, GSCA_SF_S32);
+}
+
+size_t gscaRenderAPUFormat (gscaAPU* apu, const gscaOutputFormat* format,
+    void* const* out, size_t frameCount)
+{
+    gscaExpect(apu, "Pointer 'apu' is NULL.\n");
+    gscaExpect(format, "Pointer 'format' is NULL.\n");
+    gscaExpect((unsigned) format->type <= GSCA_ST_U8, "Sample type %d is out of range.\n",
+        (int) format->type);
+    gscaExpect((unsigned) format->layout <= GSCA_SL_PLANAR, "Sample layout %d is out of range.\n",
+        (int) format->layout);
+    gscaExpect(out != NULL || frameCount == 0, "Pointer 'out' is NULL.\n");
+    return gscaRenderFormatted(apu, format, out, frameCount, UINT64_MAX);
+}
+
+size_t gscaRenderAPUFormatUntil (gscaAPU* apu, const gscaOutputFormat* format,
+    void* const* out, size_t frameCount, uint64_t cycle)
+{
+    gscaExpect(apu, "Pointer 'apu' is NULL.\n");
+    gscaExpect(format, "Pointer 'format' is NULL.\n");
+    gscaExpect((unsigned) format->type <= GSCA_ST_U8, "Sample type %d is out of range.\n",
+        (int) format->type);
+    gscaExpect((unsigned) format->layout <= GSCA_SL_PLANAR, "Sample layout %d is out of range.\n",
+        (int) format->layout);
+    gscaExpect(out != NULL || frameCount == 0, "Pointer 'out' is NULL.\n");
+
+    uint64_t now = gscaGetAPUCycles(apu);
+    if (cycle <= now) { return 0; }
+
+    return gscaRenderFormatted(apu, format, out, frameCount, cycle - now);
+}
+
+size_t gscaGetOutputFrameSize (const gscaOutputFormat* format)
+{
+    gscaExpect(format, "Pointer 'format' is NULL.\n");
+    gscaExpect((unsigned) format->type <= GSCA_ST_U8, "Sample type %d is out of range.\n",
+        (int) format->type);
+    gscaExpect((unsigned) format->layout <= GSCA_SL_PLANAR, "Sample layout %d is out of range.\n",
+        (int) format->layout);
+
+    static const size_t SIZES[] = {
+        [GSCA_ST_F32] = sizeof(float),
+        [GSCA_ST_S16] = sizeof(int16_t),
+        [GSCA_ST_S24] = 3,
+        [GSCA_ST_U8]  = sizeof(uint8_t)
+    };
+
+    return SIZES[format->type] * ((format->layout == GSCA_SL_INTERLEAVED) ? 2 : 1);
+}
+
+size_t gscaRenderAPUStems (gscaAPU* apu, gscaAudioSample* out,
+    gscaAudioSample* const* stems, size_t frameCount)
+{
+    gscaExpect(apu, "Pointer 'apu' is NULL.\n");
+    gscaExpect(stems != NULL || frameCount == 0, "Pointer 'stems' is NULL.\n");
+    return gscaRenderSamples(apu, out, stems, frameCount, UINT64_MAX, GSCA_SF_F32);
+}
+
+bool gscaSetAPUOutputTaps (gscaAPU* apu, const uint32_t* sampleRates, size_t count)
+{
+    gscaExpect(apu, "Pointer 'apu' is NULL.\n");
+    gscaExpect(sampleRates != NULL || count == 0, "Pointer 'sampleRates' is NULL.\n");
+
+    if (count > GSCA_APU_MAX_OUTPUT_TAPS)
+    {
+        gscaErr("Output tap count %zu is out of range.\n", count);
+        return false;
+    }
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (sampleRates[i] == 0 || sampleRates[i] > GSCA_CLOCK_RATE)
+        {
+            gscaErr("Sample rate %u Hz of output tap %zu is out of range.\n",
+                sampleRates[i], i);
+            return false;
+        }
+    }
+
+    gscaZero(apu->taps, GSCA_APU_MAX_OUTPUT_TAPS, gscaOutputTap);
+    for (size_t i = 0; i < count; ++i)
+        { apu->taps[i].sampleRate = sampleRates[i]; }
+    apu->tapCount = (uint32_t) count;
+    gscaInitOutputTaps(apu);
+    return true;
+}
+
+size_t gscaGetAPUOutputTapCount (const gscaAPU* apu)
+{
+    gscaExpect(apu, "Pointer 'apu' is NULL.\n");
+    return apu->tapCount;
+}
+
+uint64_t gscaRenderAPUTaps (gscaAPU* apu, gscaAudioSample* const* out, size_t* frameCounts,
+    uint64_t cycleCount)
+{
+    gscaExpect(apu, "Pointer 'apu' is NULL.\n");
+    gscaExpect(out != NULL || apu->tapCount == 0, "Pointer 'out' is NULL.\n");
+    gscaExpect(frameCounts != NULL || apu->tapCount == 0, "Pointer 'frameCounts' is NULL.\n");
+
+    // The channels are advanced as the APU's render kernel would advance them,
+    // but with the taps' sample clocks in place of the APU's own. The mix is
+    // computed at most once per step, however many taps sample it there.
+    const bool coarse = (apu->accuracy == GSCA_ACC_PREVIEW);
+    size_t frames[GSCA_APU_MAX_OUTPUT_TAPS] = { 0 };
+    uint64_t cycles = 0;
+
+    while (cycles < cycleCount)
+    {
+        uint64_t limit = cycleCount - cycles;
+        uint32_t step = (coarse) ? (0x2000 - (apu->ticks & 0x1FFF)) : gscaCyclesToNextEdge(apu);
+
+        // A tap whose buffer is full stops the render just short of the cycle
+        // on which its next sample is due.
+        for (uint32_t i = 0; i < apu->tapCount; ++i)
+        {
+            const gscaOutputTap* tap = &apu->taps[i];
+            uint32_t sampleCycles =
+                (GSCA_CLOCK_RATE - tap->samplePhase + tap->sampleRate - 1) / tap->sampleRate;
+            if (frames[i] == frameCounts[i])
+                { if (sampleCycles - 1 < limit) { limit = sampleCycles - 1; } }
+            else if (sampleCycles < step)
+                { step = sampleCycles; }
+        }
+
+        if (limit == 0) { break; }
+        if (limit < step) { step = (uint32_t) limit; }
+        cycles += step;
+
+        if (coarse)
+        {
+            gscaAdvanceChannels(apu, step);
+            if ((apu->ticks & 0x1FFF) == 0)
+                { gscaTickFrameSequencer(apu); }
+        }
+        else
+        {
+            gscaSkipCycles(apu, step - 1);
+            gscaStepAPU(apu);
+        }
+
+        gscaAudioSample mix;
+        bool mixed = false;
+        for (uint32_t i = 0; i < apu->tapCount; ++i)
+        {
+            gscaOutputTap* tap = &apu->taps[i];
+            tap->samplePhase += step * tap->sampleRate;
+            if (tap->samplePhase >= GSCA_CLOCK_RATE)
+            {
+                tap->samplePhase -= GSCA_CLOCK_RATE;
+                if (mixed == false)
+                    { gscaMixAudioSample(apu, &mix); mixed = true; }
+                gscaHighPassFilter(&tap->previousInput, &tap->previousOutput, &mix,
+                    &out[i][frames[i]++]);
+            }
+        }
+    }
+
+    for (uint32_t i = 0; i < apu->tapCount; ++i)
+    {
+        gscaFilterChain* filter = &apu->taps[i].filter;
+        if (filter->stageCount > 0)
+            { gscaApplyFilterChain(filter, 0, out[i], frames[i]); }
+        frameCounts[i] = frames[i];
+    }
+
+    return cycles;
+}
+
+gscaAPUBatch* gscaCreateAPUBatch (size_t laneCount)
+{
+    gscaExpect(laneCount > 0 && laneCount <= GSCA_APU_BATCH_LANES,
+        "Lane count %zu is out of range.\n", laneCount);
+
+    gscaAPUBatch* batch = gscaCreateZero(1, gscaAPUBatch);
+    gscaExpectp(batch, "Cannot create APU batch");
+
+    batch->laneCount = laneCount;
+    batch->sampleRate = GSCA_DEFAULT_SAMPLE_RATE;
+    for (size_t i = 0; i < laneCount; ++i)
+        { batch->lanes[i] = gscaCreateAPU(GSCA_ACC_EXACT); }
+
+    return batch;
+}
+
+void gscaDestroyAPUBatch (gscaAPUBatch* batch)
+{
+    if (batch != NULL)
+    {
+        for (size_t i = 0; i < batch->laneCount; ++i)
+            { gscaDestroyAPU(batch->lanes[i]); }
+        gscaDestroy(batch);
+    }
+}
+
+size_t gscaGetAPUBatchLaneCount (const gscaAPUBatch* batch)
+{
+    gscaExpect(batch, "Pointer 'batch' is NULL.\n");
+    return batch->laneCount;
+}
+
+gscaAPU* gscaGetAPUBatchLane (gscaAPUBatch* batch, size_t lane)
+{
+    gscaExpect(batch, "Pointer 'batch' is NULL.\n");
+    gscaCheckv(lane < batch->laneCount, NULL,
+        "Lane %zu is out of range.\n", lane);
+    return batch->lanes[lane];
+}
+
+bool gscaSetAPUBatchSampleRate (gscaAPUBatch* batch, uint32_t sampleRate)
+{
+    gscaExpect(batch, "Pointer 'batch' is NULL.\n");
+
+    for (size_t i = 0; i < batch->laneCount; ++i)
+    {
+        if (gscaSetAPUSampleRate(batch->lanes[i], sampleRate) == false)
+            { return false; }
+    }
+
+    batch->sampleRate = sampleRate;
+    return true;
+}
+
+size_t gscaRenderAPUBatch (gscaAPUBatch* batch, gscaAudioSample* const* out,
+    size_t frameCount)
+{
+    gscaExpect(batch, "Pointer 'batch' is NULL.\n");
+    gscaExpect(out != NULL || frameCount == 0, "Pointer 'out' is NULL.\n");
+
+    // The lanes' own clocks and sample rates are not used by the batch, so a
+    // lane which has been reset, rendered or reconfigured on its own is put
+    // back in step with the rest.
+    for (size_t i = 0; i < batch->laneCount; ++i)
+    {
+        gscaAPU* apu = batch->lanes[i];
+        apu->ticks = batch->ticks;
+        apu->samplePhase = batch->samplePhase;
+        if (apu->sampleRate != batch->sampleRate)
+        {
+            gscaSetAPUSampleRate(apu, batch->sampleRate);
+        }
+    }
+
+    // The lanes are advanced in lock-step, from one edge of any lane to the
+    // next, as in `gscaRenderAPU`. The lanes' states are gathered into vectors
+    // up front, and only scattered back to run the scalar frame sequencer,
+    // which is clocked rarely enough not to be worth vectorizing.
+    gscaAPULanes lanes;
+    gscaGatherAPULanes(batch, &lanes);
+
+    const uint32_t sampleRate = batch->sampleRate;
+    size_t frames = 0;
+
+    while (frames < frameCount)
+    {
+        uint32_t cycles = gscaCyclesToNextLaneEdge(batch, &lanes);
+        uint32_t sampleCycles =
+            (GSCA_CLOCK_RATE - batch->samplePhase + sampleRate - 1) / sampleRate;
+        if (sampleCycles < cycles) { cycles = sampleCycles; }
+
+        gscaSkipLaneCycles(batch, &lanes, cycles - 1);
+        batch->ticks++;
+        batch->samplePhase += cycles * sampleRate;
+
+        // The channels are clocked in the same order as in `gscaStepAPU`.
+        if ((batch->ticks & 0b1) == 0)
+        {
+            gscaTickWaveLanes(batch, &lanes.wave);
+            if ((batch->ticks & 0b11) == 0)
+            {
+                gscaTickPulseLanes(&lanes.pulse[GSCA_AC_PULSE1]);
+                gscaTickPulseLanes(&lanes.pulse[GSCA_AC_PULSE2]);
+            }
+        }
+
+        gscaTickNoiseLanes(&lanes.noise, batch->ticks);
+
+        if ((batch->ticks & 0x1FFF) == 0)
+        {
+            gscaScatterAPULanes(batch, &lanes);
+            for (size_t i = 0; i < batch->laneCount; ++i)
+                { gscaTickFrameSequencer(batch->lanes[i]); }
+            gscaGatherAPULanes(batch, &lanes);
+        }
+
+        if (batch->samplePhase >= GSCA_CLOCK_RATE)
+        {
+            batch->samplePhase -= GSCA_CLOCK_RATE;
+            gscaMixAPULanes(&lanes);
+            for (size_t i = 0; i < batch->laneCount; ++i)
+            {
+                out[i][frames] = (gscaAudioSample) {
+                    .left = lanes.currentLeft[i],
+                    .right = lanes.currentRight[i]
+                };
+            }
+
+            frames++;
+        }
+    }
+
+    gscaScatterAPULanes(batch, &lanes);
+    for (size_t i = 0; i < batch->laneCount; ++i)
+    {
+        gscaFilterChain* filter = &batch->lanes[i]->filter;
+        if (filter->stageCount > 0)
+            { gscaApplyFilterChain(filter, 0, out[i], frames); }
+    }
+
+    return frames;
+}
+
+uint8_t gscaReadNR52 (const gscaAPU* apu)
+{
+    gscaExpect(apu, "Pointer 'apu' is NULL.\n");
+    return apu->nr52.value | apu->hot.enable;
+}
+
+uint8_t gscaReadNR51 (const gscaAPU* apu)
+{
+    gscaExpect(apu, "Pointer 'apu' is NULL.\n");
+    return apu->nr51.value;
+}
+
+uint8_t gscaReadNR50 (const gscaAPU* apu)
+{
+    gscaExpect(apu, "Pointer 'apu' is NULL.\n");
+    return apu->nr50.value;
+}
+
+uint8_t gscaReadNR10 (const gscaAPU* apu)
+{
+    gscaExpect(apu, "Pointer 'apu' is NULL.\n");
+    return apu->nr10.value;
+}
+
+uint8_t gscaReadNR11 (const gscaAPU* apu)
+{
     gscaExpect(apu, "Pointer 'apu' is NULL.\n");
     return apu->nr11.value & 0b11000000;
 }
@@ -650,272 +3138,155 @@ uint8_t gscaReadNR44 (const gscaAPU* apu)
 void gscaWriteNR52 (gscaAPU* apu, uint8_t value)
 {
     gscaExpect(apu, "Pointer 'apu' is NULL.\n");
-    apu->nr52.value |= (value & 0b11110000);
-    if (apu->nr52.masterEnable == false)
-    {
-        apu->nr52.value = 0x00;
-        apu->nr51.value = 0x00;
-        apu->nr50.value = 0x00;
-        apu->nr10.value = 0x00;
-        apu->nr11.value = 0x00;
-        apu->nr12.value = 0x00;
-        apu->nr13.value = 0x00;
-        apu->nr14.value = 0x00;
-        apu->nr21.value = 0x00;
-        apu->nr22.value = 0x00;
-        apu->nr23.value = 0x00;
-        apu->nr24.value = 0x00;
-        apu->nr30.value = 0x00;
-        apu->nr31.value = 0x00;
-        apu->nr32.value = 0x00;
-        apu->nr33.value = 0x00;
-        apu->nr34.value = 0x00;
-        apu->nr41.value = 0x00;
-        apu->nr42.value = 0x00;
-        apu->nr43.value = 0x00;
-        apu->nr44.value = 0x00;
-    }
+    gscaApplyRegisterWrite(apu, GSCA_AR_NR52, value);
 }
 
 void gscaWriteNR51 (gscaAPU* apu, uint8_t value)
 {
     gscaExpect(apu, "Pointer 'apu' is NULL.\n");
-    if (apu->nr52.masterEnable == true)
-    {
-        apu->nr51.value = value;
-    }
+    gscaApplyRegisterWrite(apu, GSCA_AR_NR51, value);
 }
 
 void gscaWriteNR50 (gscaAPU* apu, uint8_t value)
 {
     gscaExpect(apu, "Pointer 'apu' is NULL.\n");
-    if (apu->nr52.masterEnable == true)
-    {
-        apu->nr50.value = value;
-    }
+    gscaApplyRegisterWrite(apu, GSCA_AR_NR50, value);
 }
 
 void gscaWriteNR10 (gscaAPU* apu, uint8_t value)
 {
     gscaExpect(apu, "Pointer 'apu' is NULL.\n");
-    if (apu->nr52.masterEnable == true)
-    {
-        apu->nr10.value = value;
-    }
+    gscaApplyRegisterWrite(apu, GSCA_AR_NR10, value);
 }
 
 void gscaWriteNR11 (gscaAPU* apu, uint8_t value)
 {
     gscaExpect(apu, "Pointer 'apu' is NULL.\n");
-    if (apu->nr52.masterEnable == true)
-    {
-        apu->nr11.value = value;
-    }
+    gscaApplyRegisterWrite(apu, GSCA_AR_NR11, value);
 }
 
 void gscaWriteNR12 (gscaAPU* apu, uint8_t value)
 {
     gscaExpect(apu, "Pointer 'apu' is NULL.\n");
-    if (apu->nr52.masterEnable == true)
-    {
-        apu->nr12.value = value;
-        if (
-            apu->nr12.envelopeDirection == GSCA_ESD_DECREASE &&
-            apu->nr12.initialVolume == 0
-        )
-        {
-            apu->pulse1.dacEnable = false;
-            apu->nr52.pulse1Enable = false;
-        }
-        else
-        {
-            apu->pulse1.dacEnable = true;
-        }
-    }
+    gscaApplyRegisterWrite(apu, GSCA_AR_NR12, value);
 }
 
 void gscaWriteNR13 (gscaAPU* apu, uint8_t value)
 {
     gscaExpect(apu, "Pointer 'apu' is NULL.\n");
-    if (apu->nr52.masterEnable == true)
-    {
-        apu->nr13.value = value;
-        gscaResetPeriod(apu, GSCA_AC_PULSE1);
-    }
+    gscaApplyRegisterWrite(apu, GSCA_AR_NR13, value);
 }
 
 void gscaWriteNR14 (gscaAPU* apu, uint8_t value)
 {
     gscaExpect(apu, "Pointer 'apu' is NULL.\n");
-    if (apu->nr52.masterEnable == true)
-    {
-        apu->nr14.value = value;
-        gscaResetPeriod(apu, GSCA_AC_PULSE1);
-        if (apu->nr14.trigger == true)
-        {
-            gscaTriggerChannel(apu, GSCA_AC_PULSE1);
-        }
-    }
+    gscaApplyRegisterWrite(apu, GSCA_AR_NR14, value);
 }
 
 void gscaWriteNR21 (gscaAPU* apu, uint8_t value)
 {
     gscaExpect(apu, "Pointer 'apu' is NULL.\n");
-    if (apu->nr52.masterEnable == true)
-    {
-        apu->nr21.value = value;
-    }
+    gscaApplyRegisterWrite(apu, GSCA_AR_NR21, value);
 }
 
 void gscaWriteNR22 (gscaAPU* apu, uint8_t value)
 {
     gscaExpect(apu, "Pointer 'apu' is NULL.\n");
-    if (apu->nr52.masterEnable == true)
-    {
-        apu->nr22.value = value;
-        if (
-            apu->nr22.envelopeDirection == GSCA_ESD_DECREASE &&
-            apu->nr22.initialVolume == 0
-        )
-        {
-            apu->pulse2.dacEnable = false;
-            apu->nr52.pulse2Enable = false;
-        }
-        else
-        {
-            apu->pulse2.dacEnable = true;
-        }
-    }
+    gscaApplyRegisterWrite(apu, GSCA_AR_NR22, value);
 }
 
 void gscaWriteNR23 (gscaAPU* apu, uint8_t value)
 {
     gscaExpect(apu, "Pointer 'apu' is NULL.\n");
-    if (apu->nr52.masterEnable == true)
-    {
-        apu->nr23.value = value;
-        gscaResetPeriod(apu, GSCA_AC_PULSE2);
-    }
+    gscaApplyRegisterWrite(apu, GSCA_AR_NR23, value);
 }
 
 void gscaWriteNR24 (gscaAPU* apu, uint8_t value)
 {
     gscaExpect(apu, "Pointer 'apu' is NULL.\n");
-    if (apu->nr52.masterEnable == true)
-    {
-        apu->nr24.value = value;
-        gscaResetPeriod(apu, GSCA_AC_PULSE2);
-        if (apu->nr24.trigger == true)
-        {
-            gscaTriggerChannel(apu, GSCA_AC_PULSE2);
-        }
-    }
+    gscaApplyRegisterWrite(apu, GSCA_AR_NR24, value);
 }
 
 void gscaWriteNR30 (gscaAPU* apu, uint8_t value)
 {
     gscaExpect(apu, "Pointer 'apu' is NULL.\n");
-    if (apu->nr52.masterEnable == true)
-    {
-        apu->nr30.value = value;
-        if (apu->nr30.enable == false)
-        {
-            apu->nr52.waveEnable = false;
-        }
-    }
+    gscaApplyRegisterWrite(apu, GSCA_AR_NR30, value);
 }
 
 void gscaWriteNR31 (gscaAPU* apu, uint8_t value)
 {
     gscaExpect(apu, "Pointer 'apu' is NULL.\n");
-    if (apu->nr52.masterEnable == true)
-    {
-        apu->nr31.value = value;
-    }
+    gscaApplyRegisterWrite(apu, GSCA_AR_NR31, value);
 }
 
 void gscaWriteNR32 (gscaAPU* apu, uint8_t value)
 {
     gscaExpect(apu, "Pointer 'apu' is NULL.\n");
-    if (apu->nr52.masterEnable == true)
-    {
-        apu->nr32.value = value;
-    }
+    gscaApplyRegisterWrite(apu, GSCA_AR_NR32, value);
 }
 
 void gscaWriteNR33 (gscaAPU* apu, uint8_t value)
 {
     gscaExpect(apu, "Pointer 'apu' is NULL.\n");
-    if (apu->nr52.masterEnable == true)
-    {
-        apu->nr33.value = value;
-        gscaResetPeriod(apu, GSCA_AC_WAVE);
-    }
+    gscaApplyRegisterWrite(apu, GSCA_AR_NR33, value);
 }
 
 void gscaWriteNR34 (gscaAPU* apu, uint8_t value)
 {
     gscaExpect(apu, "Pointer 'apu' is NULL.\n");
-    if (apu->nr52.masterEnable == true)
-    {
-        apu->nr34.value = value;
-        gscaResetPeriod(apu, GSCA_AC_WAVE);
-        if (apu->nr34.trigger == true)
-        {
-            gscaTriggerChannel(apu, GSCA_AC_WAVE);
-        }
-    }
+    gscaApplyRegisterWrite(apu, GSCA_AR_NR34, value);
 }
 
 void gscaWriteNR41 (gscaAPU* apu, uint8_t value)
 {
     gscaExpect(apu, "Pointer 'apu' is NULL.\n");
-    if (apu->nr52.masterEnable == true)
-    {
-        apu->nr41.value = value;
-    }
+    gscaApplyRegisterWrite(apu, GSCA_AR_NR41, value);
 }
 
 void gscaWriteNR42 (gscaAPU* apu, uint8_t value)
 {
     gscaExpect(apu, "Pointer 'apu' is NULL.\n");
-    if (apu->nr52.masterEnable == true)
-    {
-        apu->nr42.value = value;
-        if (
-            apu->nr42.envelopeDirection == GSCA_ESD_DECREASE &&
-            apu->nr42.initialVolume == 0
-        )
-        {
-            apu->noise.dacEnable = false;
-            apu->nr52.noiseEnable = false;
-        }
-        else
-        {
-            apu->noise.dacEnable = true;
-        }
-    }
+    gscaApplyRegisterWrite(apu, GSCA_AR_NR42, value);
 }
 
 void gscaWriteNR43 (gscaAPU* apu, uint8_t value)
 {
     gscaExpect(apu, "Pointer 'apu' is NULL.\n");
-    if (apu->nr52.masterEnable == true)
+    gscaApplyRegisterWrite(apu, GSCA_AR_NR43, value);
+}
+
+void gscaWriteNR44 (gscaAPU* apu, uint8_t value)
+{
+    gscaExpect(apu, "Pointer 'apu' is NULL.\n");
+    gscaApplyRegisterWrite(apu, GSCA_AR_NR44, value);
+}
+
+void gscaWriteRegister (gscaAPU* apu, uint8_t address, uint8_t value)
+{
+    gscaExpect(apu, "Pointer 'apu' is NULL.\n");
+    if (gscaIsRegisterMapped(address) == true)
     {
-        apu->nr43.value = value;
-        gscaUpdateNoiseClockFrequency(apu);
+        gscaApplyRegisterWrite(apu, address, value);
     }
 }
 
-void gscaWriteNR44 (gscaAPU* apu, uint8_t value)
+bool gscaWriteRegisters (gscaAPU* apu, const gscaRegisterWrite* writes, size_t count)
 {
     gscaExpect(apu, "Pointer 'apu' is NULL.\n");
-    if (apu->nr52.masterEnable == true)
+    gscaExpect(writes != NULL || count == 0, "Pointer 'writes' is NULL.\n");
+
+    // Validate the whole list up front, so that it is applied all or nothing,
+    // then apply it without checking each write again.
+    for (size_t i = 0; i < count; ++i)
     {
-        apu->nr44.value = value;
-        if (apu->nr44.trigger == true)
-        {
-            gscaTriggerChannel(apu, GSCA_AC_NOISE);
-        }
+        gscaCheckv(gscaIsRegisterMapped(writes[i].address) == true, false,
+            "Register write #%zu has unmapped address $FF%02X.\n", i, writes[i].address);
+    }
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        gscaApplyRegisterWrite(apu, writes[i].address, writes[i].value);
     }
+
+    return true;
 }
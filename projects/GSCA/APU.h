@@ -4,11 +4,12 @@
  */
 
 #pragma once
-#include <GSCA/Common.h>
+#include <GSCA/RegisterLog.h>
 
 /* Typedefs and Forward Declarations ******************************************/
 
 typedef struct gscaAPU gscaAPU;
+typedef struct gscaAPUBatch gscaAPUBatch;
 
 /* Enumerations ***************************************************************/
 
@@ -67,6 +68,94 @@ typedef enum
     GSCA_WOL_QUARTER
 } gscaWaveOutputLevel;
 
+/**
+ * @brief   Enumerates the models of the output filter chain which is applied to
+ *          the APU's rendered audio.
+ */
+typedef enum
+{
+    GSCA_FM_FLAT,       ///< @brief No filtering beyond the APU's own DC blocking.
+    GSCA_FM_DMG,        ///< @brief The DMG's output capacitor (one-pole high-pass, ~28 Hz).
+    GSCA_FM_CGB,        ///< @brief The CGB's output capacitor (one-pole high-pass, ~700 Hz).
+    GSCA_FM_AGB         ///< @brief An approximation of the AGB's built-in speaker.
+} gscaFilterModel;
+
+/**
+ * @brief   Enumerates the accuracy tiers at which the APU can render audio.
+ *
+ * The preview tier advances each channel straight from one output sample to
+ * the next, however many times it is clocked in between, which takes roughly
+ * half of the exact tier's time. Point-sampled output is unaffected, but the
+ * band-limited output stage sees each change in level on the output sample
+ * after it, rather than on the cycle it occurred.
+ */
+typedef enum
+{
+    GSCA_ACC_EXACT,     ///< @brief Cycle-accurate; identical to stepping with @a gscaTickAPU.
+    GSCA_ACC_PREVIEW    ///< @brief Advances the channels once per output sample.
+} gscaAccuracy;
+
+/**
+ * @brief   Enumerates the sample types which @a gscaRenderAPUFormat can write.
+ */
+typedef enum
+{
+    GSCA_ST_F32,        ///< @brief 32-bit float, full scale at `±1.0`.
+    GSCA_ST_S16,        ///< @brief Signed 16-bit integer.
+    GSCA_ST_S24,        ///< @brief Signed 24-bit integer, packed into 3 little-endian bytes.
+    GSCA_ST_U8          ///< @brief Unsigned 8-bit integer, centered on `128`.
+} gscaSampleType;
+
+/**
+ * @brief   Enumerates the ways in which @a gscaRenderAPUFormat can lay out the
+ *          left and right channels of its output.
+ */
+typedef enum
+{
+    GSCA_SL_INTERLEAVED,    ///< @brief One buffer, alternating left and right samples.
+    GSCA_SL_PLANAR          ///< @brief Two buffers, one for each channel.
+} gscaSampleLayout;
+
+/**
+ * @brief   Enumerates the addresses of the APU's hardware registers, relative
+ *          to `$FF00`.
+ */
+typedef enum
+{
+    GSCA_AR_NR10        = 0x10,
+    GSCA_AR_NR11        = 0x11,
+    GSCA_AR_NR12        = 0x12,
+    GSCA_AR_NR13        = 0x13,
+    GSCA_AR_NR14        = 0x14,
+    GSCA_AR_NR21        = 0x16,
+    GSCA_AR_NR22        = 0x17,
+    GSCA_AR_NR23        = 0x18,
+    GSCA_AR_NR24        = 0x19,
+    GSCA_AR_NR30        = 0x1A,
+    GSCA_AR_NR31        = 0x1B,
+    GSCA_AR_NR32        = 0x1C,
+    GSCA_AR_NR33        = 0x1D,
+    GSCA_AR_NR34        = 0x1E,
+    GSCA_AR_NR41        = 0x20,
+    GSCA_AR_NR42        = 0x21,
+    GSCA_AR_NR43        = 0x22,
+    GSCA_AR_NR44        = 0x23,
+    GSCA_AR_NR50        = 0x24,
+    GSCA_AR_NR51        = 0x25,
+    GSCA_AR_NR52        = 0x26,
+    GSCA_AR_WAVE_RAM    = 0x30
+} gscaAudioRegister;
+
+/**
+ * @brief   A single write to one of the APU's hardware registers, as submitted
+ *          in a list to @a gscaWriteRegisters.
+ */
+typedef struct
+{
+    uint8_t address;    ///< @brief The register's address, relative to `$FF00`.
+    uint8_t value;      ///< @brief The register's new value.
+} gscaRegisterWrite;
+
 /* Hardware Register Unions ***************************************************/
 
 /**
@@ -280,14 +369,49 @@ typedef struct
     float left, right;
 } gscaAudioSample;
 
+/**
+ * @brief   Contains a signed 16-bit integer sample output from the APU.
+ */
+typedef struct
+{
+    int16_t left, right;
+} gscaAudioSampleS16;
+
+/**
+ * @brief   Contains a signed 32-bit integer sample output from the APU.
+ */
+typedef struct
+{
+    int32_t left, right;
+} gscaAudioSampleS32;
+
+/* Output Format Structure ****************************************************/
+
+/**
+ * @brief   Describes the format in which @a gscaRenderAPUFormat writes its
+ *          audio samples.
+ */
+typedef struct
+{
+    gscaSampleType      type;       ///< @brief The type of each sample.
+    gscaSampleLayout    layout;     ///< @brief The layout of the channels.
+    bool                dither;     ///< @brief Whether to add TPDF dither to integer samples.
+} gscaOutputFormat;
+
 /* Public Function Prototypes *************************************************/
 
 /**
  * @brief   Creates a new GSCA APU emulation context.
- * 
+ *
+ * The accuracy tier selects the kernel used by the APU's render functions,
+ * once, for the lifetime of the context. It does not affect @a gscaTickAPU,
+ * which always steps through single clock cycles.
+ *
+ * @param   accuracy    The emulation context's accuracy tier.
+ *
  * @return  A pointer to the new emulation context.
  */
-GSCA_API gscaAPU* gscaCreateAPU ();
+GSCA_API gscaAPU* gscaCreateAPU (gscaAccuracy accuracy);
 
 /**
  * @brief   Resets the given GSCA APU emulation context, zeroing out its
@@ -305,6 +429,129 @@ GSCA_API void gscaResetAPU (gscaAPU* apu);
  */
 GSCA_API void gscaDestroyAPU (gscaAPU* apu);
 
+/**
+ * @brief   Enables or disables the APU's band-limited output stage.
+ *
+ * By default, each output sample point-samples the channels' DAC outputs,
+ * which aliases at high pulse and noise frequencies. With the band-limited
+ * output stage enabled, every change in the mixed output level is recorded at
+ * the exact cycle on which it occurs, and the output samples are synthesized
+ * from these steps with a windowed-sinc kernel. This delays the output by
+ * `GSCA_BLIP_TAPS / 2` samples.
+ *
+ * @param   apu     A pointer to the GSCA APU emulation context.
+ * @param   enable  `true` to enable the band-limited output stage; `false` to
+ *                  return to point-sampled output.
+ */
+GSCA_API void gscaSetBandLimitedOutput (gscaAPU* apu, bool enable);
+
+/**
+ * @brief   Sets the rate at which the APU outputs audio samples.
+ *
+ * The APU's sample clock is a fixed-point phase accumulator, advanced by the
+ * sample rate on every clock cycle, so any sample rate is produced exactly,
+ * without drift, rather than being rounded to a whole number of clock cycles
+ * per sample. The sample rate is kept across calls to @a gscaResetAPU.
+ *
+ * @param   apu         A pointer to the GSCA APU emulation context.
+ * @param   sampleRate  The new sample rate, in Hz. Must be between `1` and
+ *                      `GSCA_CLOCK_RATE`.
+ *
+ * @return  `true` if the sample rate was set; `false` if it is out of range.
+ */
+GSCA_API bool gscaSetAPUSampleRate (gscaAPU* apu, uint32_t sampleRate);
+
+/**
+ * @brief   Retrieves the rate at which the APU outputs audio samples.
+ *
+ * @param   apu     A pointer to the GSCA APU emulation context.
+ *
+ * @return  The APU's sample rate, in Hz.
+ */
+GSCA_API uint32_t gscaGetAPUSampleRate (const gscaAPU* apu);
+
+/**
+ * @brief   Sets the model of the output filter chain applied to the audio
+ *          rendered by the APU.
+ *
+ * The filter chain is a cascade of biquads, which is run over each buffer of
+ * audio samples rendered by @a gscaRenderAPU, @a gscaRenderAPUUntil,
+ * @a gscaRenderAPUStems, @a gscaRenderAPUTaps and @a gscaRenderAPUBatch, once
+ * it has been rendered, and over each sample output by @a gscaTickAPU. It does
+ * not apply to the integer sample formats. The model is kept across calls to
+ * @a gscaResetAPU.
+ *
+ * @param   apu     A pointer to the GSCA APU emulation context.
+ * @param   model   The filter model. Defaults to `GSCA_FM_FLAT`.
+ */
+GSCA_API void gscaSetAPUFilterModel (gscaAPU* apu, gscaFilterModel model);
+
+/**
+ * @brief   Retrieves the model of the APU's output filter chain.
+ *
+ * @param   apu     A pointer to the GSCA APU emulation context.
+ *
+ * @return  The filter model.
+ */
+GSCA_API gscaFilterModel gscaGetAPUFilterModel (const gscaAPU* apu);
+
+/**
+ * @brief   Adds an optional low-pass filter to the end of the APU's output
+ *          filter chain, to tame the harshness of its square waves.
+ *
+ * @param   apu     A pointer to the GSCA APU emulation context.
+ * @param   cutoff  The low-pass filter's cutoff frequency, in Hz, or `0` to
+ *                  remove it. Must be below half of the APU's sample rate.
+ *
+ * @return  `true` if the cutoff was set; `false` if it is out of range.
+ */
+GSCA_API bool gscaSetAPULowPassCutoff (gscaAPU* apu, float cutoff);
+
+/**
+ * @brief   Retrieves the size of a snapshot of the APU's current state, as
+ *          saved by @a gscaSaveAPUState.
+ *
+ * @param   apu     A pointer to the GSCA APU emulation context.
+ *
+ * @return  The size of the snapshot, in bytes.
+ */
+GSCA_API size_t gscaGetAPUStateSize (const gscaAPU* apu);
+
+/**
+ * @brief   Saves a snapshot of the APU's current state into the given buffer.
+ *
+ * The snapshot covers the channels, wave RAM, registers, the high-pass filter
+ * history, the tick, frame sequencer and sample clock counters, and the
+ * band-limited output stage if it is enabled. Snapshots are versioned, and can
+ * only be loaded by a build of the library with the same snapshot version on
+ * the same architecture.
+ *
+ * @param   apu     A pointer to the GSCA APU emulation context.
+ * @param   buffer  A pointer to the buffer to save the snapshot into.
+ * @param   size    The size of the buffer, which must be at least
+ *                  @a gscaGetAPUStateSize bytes.
+ *
+ * @return  The number of bytes written to the buffer, or `0` if it is too
+ *          small.
+ */
+GSCA_API size_t gscaSaveAPUState (const gscaAPU* apu, void* buffer, size_t size);
+
+/**
+ * @brief   Restores the APU's state from a snapshot saved by
+ *          @a gscaSaveAPUState.
+ *
+ * This also enables or disables the band-limited output stage, to match the
+ * APU which the snapshot was saved from.
+ *
+ * @param   apu     A pointer to the GSCA APU emulation context.
+ * @param   buffer  A pointer to the buffer holding the snapshot.
+ * @param   size    The size of the buffer, in bytes.
+ *
+ * @return  `true` if the snapshot was loaded, `false` if it is invalid or was
+ *          saved by an incompatible version of the library.
+ */
+GSCA_API bool gscaLoadAPUState (gscaAPU* apu, const void* buffer, size_t size);
+
 /**
  * @brief   Retrieves the current state of the APU's current audio sample.
  * 
@@ -324,6 +571,89 @@ GSCA_API const gscaAudioSample* gscaGetCurrentSample (const gscaAPU* apu);
  */
 GSCA_API bool gscaSetWavePattern (gscaAPU* apu, const char* pattern);
 
+/**
+ * @brief   Sets the contents of the APU's wave RAM, which holds the pattern
+ *          used by its wave channel.
+ *
+ * @param   apu     A pointer to the GSCA APU emulation context.
+ * @param   waveRAM The new wave pattern, as 16 bytes of two samples each, the
+ *                  first in the upper nibble.
+ */
+GSCA_API void gscaSetWaveRAM (gscaAPU* apu, const uint8_t waveRAM[GSCA_WAVE_RAM_SIZE]);
+
+/**
+ * @brief   Sets the bank of wave patterns which @a gscaSelectWavePattern
+ *          selects from.
+ *
+ * The bank is not copied, and must outlive its use by the APU. It is kept when
+ * the APU is reset.
+ *
+ * @param   apu         A pointer to the GSCA APU emulation context.
+ * @param   patterns    A pointer to the bank's wave patterns, in the format
+ *                      taken by @a gscaSetWaveRAM, or `NULL` to restore the
+ *                      APU's built-in bank.
+ * @param   count       The number of wave patterns in the bank.
+ */
+GSCA_API void gscaSetWaveBank (gscaAPU* apu, const uint8_t (*patterns)[GSCA_WAVE_RAM_SIZE],
+    size_t count);
+
+/**
+ * @brief   Retrieves the number of wave patterns in the APU's wave pattern bank.
+ *
+ * @param   apu     A pointer to the GSCA APU emulation context.
+ *
+ * @return  The number of wave patterns in the bank.
+ */
+GSCA_API size_t gscaGetWaveBankSize (const gscaAPU* apu);
+
+/**
+ * @brief   Copies a wave pattern from the APU's wave pattern bank into its wave
+ *          RAM.
+ *
+ * @param   apu     A pointer to the GSCA APU emulation context.
+ * @param   index   The index of the wave pattern in the bank.
+ *
+ * @return  `true` if the index is in range; `false` if not.
+ */
+GSCA_API bool gscaSelectWavePattern (gscaAPU* apu, size_t index);
+
+/**
+ * @brief   Retrieves a wave pattern from the APU's wave pattern bank.
+ *
+ * @param   apu     A pointer to the GSCA APU emulation context.
+ * @param   index   The index of the wave pattern in the bank.
+ *
+ * @return  A pointer to the pattern's 16 bytes, in the format taken by
+ *          @a gscaSetWaveRAM, or `NULL` if the index is out of range.
+ */
+GSCA_API const uint8_t* gscaGetWavePattern (const gscaAPU* apu, size_t index);
+
+/**
+ * @brief   Retrieves the number of clock cycles which the APU has run for since
+ *          it was last reset.
+ *
+ * @param   apu     A pointer to the GSCA APU emulation context.
+ *
+ * @return  The APU's cycle count.
+ */
+GSCA_API uint64_t gscaGetAPUCycles (const gscaAPU* apu);
+
+/**
+ * @brief   Starts or stops capturing the writes made to the APU's hardware
+ *          registers.
+ *
+ * While capturing, every write made through @a gscaWriteRegister,
+ * @a gscaWriteRegisters, the `gscaWriteNRxx` functions or
+ * @a gscaSetWavePattern is appended to the given
+ * register log, stamped with the APU's cycle count at the time of the write.
+ * The log is not owned by the APU, and is kept when the APU is reset.
+ *
+ * @param   apu     A pointer to the GSCA APU emulation context.
+ * @param   log     A pointer to the register log to capture writes to, or
+ *                  `NULL` to stop capturing.
+ */
+GSCA_API void gscaSetAPURegisterLog (gscaAPU* apu, gscaRegisterLog* log);
+
 /**
  * @brief   Ticks the APU, updating its internal state and channels.
  * 
@@ -333,6 +663,282 @@ GSCA_API bool gscaSetWavePattern (gscaAPU* apu, const char* pattern);
  */
 GSCA_API bool gscaTickAPU (gscaAPU* apu);
 
+/**
+ * @brief   Runs the APU until the given number of audio samples have been
+ *          output, writing each one into the given buffer.
+ *
+ * This produces the same output as calling @a gscaTickAPU repeatedly and
+ * collecting the current sample whenever it returns `true`, but only steps
+ * through the clock cycles on which the APU's state or output can change;
+ * the cycles in between are skipped in bulk.
+ *
+ * @param   apu         A pointer to the GSCA APU emulation context.
+ * @param   out         A pointer to an interleaved stereo buffer with room for
+ *                      at least `frameCount` samples.
+ * @param   frameCount  The number of audio samples to output.
+ *
+ * @return  The number of audio samples written to the buffer.
+ */
+GSCA_API size_t gscaRenderAPU (gscaAPU* apu, gscaAudioSample* out, size_t frameCount);
+
+/**
+ * @brief   Runs the APU as @a gscaRenderAPU does, but stops as soon as its cycle
+ *          count reaches the given cycle, even if that falls between two audio
+ *          samples.
+ *
+ * This lets register writes be made on the exact cycle they are due, with the
+ * output identical to making them between calls to @a gscaTickAPU.
+ *
+ * @param   apu         A pointer to the GSCA APU emulation context.
+ * @param   out         A pointer to an interleaved stereo buffer with room for
+ *                      at least `frameCount` samples.
+ * @param   frameCount  The maximum number of audio samples to output.
+ * @param   cycle       The cycle (see @a gscaGetAPUCycles) to stop on.
+ *
+ * @return  The number of audio samples written to the buffer.
+ */
+GSCA_API size_t gscaRenderAPUUntil (gscaAPU* apu, gscaAudioSample* out, size_t frameCount,
+    uint64_t cycle);
+
+/**
+ * @brief   Runs the APU until the given number of audio samples have been
+ *          output, writing each one into the given buffer as a signed 16-bit
+ *          integer sample.
+ *
+ * Unlike @a gscaRenderAPU, this mixes the channels' DAC levels, scales them by
+ * the master volume and high-pass filters them entirely in fixed point. The
+ * fixed-point pipeline keeps its own filter state, so it is meant to be used
+ * in place of, not alongside, the floating-point pipeline.
+ *
+ * @param   apu         A pointer to the GSCA APU emulation context.
+ * @param   out         A pointer to an interleaved stereo buffer with room for
+ *                      at least `frameCount` samples.
+ * @param   frameCount  The number of audio samples to output.
+ *
+ * @return  The number of audio samples written to the buffer.
+ */
+GSCA_API size_t gscaRenderAPUS16 (gscaAPU* apu, gscaAudioSampleS16* out, size_t frameCount);
+
+/**
+ * @brief   Runs the APU until the given number of audio samples have been
+ *          output, writing each one into the given buffer as a signed 32-bit
+ *          integer sample.
+ *
+ * This uses the same fixed-point pipeline as @a gscaRenderAPUS16.
+ *
+ * @param   apu         A pointer to the GSCA APU emulation context.
+ * @param   out         A pointer to an interleaved stereo buffer with room for
+ *                      at least `frameCount` samples.
+ * @param   frameCount  The number of audio samples to output.
+ *
+ * @return  The number of audio samples written to the buffer.
+ */
+GSCA_API size_t gscaRenderAPUS32 (gscaAPU* apu, gscaAudioSampleS32* out, size_t frameCount);
+
+/**
+ * @brief   Runs the APU until the given number of audio samples have been
+ *          output, converting each one into the given output format as it is
+ *          written.
+ *
+ * The samples are rendered as @a gscaRenderAPU renders them, a block at a time,
+ * and each block is converted while it is still in cache. Integer samples are
+ * rounded to the nearest value and clamped to their type's range, after the
+ * optional dither is added.
+ *
+ * @param   apu         A pointer to the GSCA APU emulation context.
+ * @param   format      A pointer to the output format.
+ * @param   out         An array of buffers: one, for the interleaved layout, or
+ *                      two (left, then right) for the planar layout. Each must
+ *                      have room for at least `frameCount` samples per channel.
+ * @param   frameCount  The number of audio samples to output.
+ *
+ * @return  The number of audio samples written to the buffers.
+ */
+GSCA_API size_t gscaRenderAPUFormat (gscaAPU* apu, const gscaOutputFormat* format,
+    void* const* out, size_t frameCount);
+
+/**
+ * @brief   Runs the APU as @a gscaRenderAPUFormat does, but stops as soon as its
+ *          cycle count reaches the given cycle, even if that falls between two
+ *          audio samples.
+ *
+ * @param   apu         A pointer to the GSCA APU emulation context.
+ * @param   format      A pointer to the output format.
+ * @param   out         An array of buffers, as for @a gscaRenderAPUFormat.
+ * @param   frameCount  The maximum number of audio samples to output.
+ * @param   cycle       The cycle (see @a gscaGetAPUCycles) to stop on.
+ *
+ * @return  The number of audio samples written to the buffers.
+ */
+GSCA_API size_t gscaRenderAPUFormatUntil (gscaAPU* apu, const gscaOutputFormat* format,
+    void* const* out, size_t frameCount, uint64_t cycle);
+
+/**
+ * @brief   Retrieves the number of bytes which one audio sample takes up in each
+ *          of the buffers written in the given output format.
+ *
+ * @param   format      A pointer to the output format.
+ *
+ * @return  The size of one audio sample, in bytes, per buffer.
+ */
+GSCA_API size_t gscaGetOutputFrameSize (const gscaOutputFormat* format);
+
+/**
+ * @brief   Runs the APU until the given number of audio samples have been
+ *          output, writing each audio channel's output into its own buffer
+ *          alongside the mixed output.
+ *
+ * Each channel's stem is its DAC output after panning and the master volume,
+ * high-pass filtered on its own in the same way as the mixed output, so the
+ * stems add up to the mixed output. The stems are always point-sampled, even
+ * if the band-limited output stage is enabled.
+ *
+ * @param   apu         A pointer to the GSCA APU emulation context.
+ * @param   out         A pointer to an interleaved stereo buffer with room for
+ *                      at least `frameCount` samples, or `NULL` if only the
+ *                      stems are wanted.
+ * @param   stems       An array of `GSCA_AUDIO_CHANNEL_COUNT` interleaved stereo
+ *                      buffers, indexed by @a gscaAudioChannel, each with room
+ *                      for at least `frameCount` samples. Any of them may be
+ *                      `NULL` to skip that channel.
+ * @param   frameCount  The number of audio samples to output.
+ *
+ * @return  The number of audio samples written to each buffer.
+ */
+GSCA_API size_t gscaRenderAPUStems (gscaAPU* apu, gscaAudioSample* out,
+    gscaAudioSample* const* stems, size_t frameCount);
+
+/**
+ * @brief   Sets the sample rates of the APU's output taps, which sample its
+ *          output at rates of their own.
+ *
+ * Each tap has its own sample clock and high-pass filter, and its own copy of
+ * the output filter chain, designed for its sample rate. The taps are all fed
+ * by one run of the channel emulation in @a gscaRenderAPUTaps, so each extra
+ * rate costs only its mixing. The taps are kept across calls to
+ * @a gscaResetAPU, but their sample clocks and filters are reset.
+ *
+ * @param   apu         A pointer to the GSCA APU emulation context.
+ * @param   sampleRates The taps' sample rates, in Hz, each between `1` and
+ *                      `GSCA_CLOCK_RATE`.
+ * @param   count       The number of taps, up to `GSCA_APU_MAX_OUTPUT_TAPS`, or
+ *                      `0` to remove them all.
+ *
+ * @return  `true` if the taps were set; `false` if any of them is out of range.
+ */
+GSCA_API bool gscaSetAPUOutputTaps (gscaAPU* apu, const uint32_t* sampleRates, size_t count);
+
+/**
+ * @brief   Retrieves the number of output taps set on the APU.
+ *
+ * @param   apu     A pointer to the GSCA APU emulation context.
+ *
+ * @return  The number of output taps.
+ */
+GSCA_API size_t gscaGetAPUOutputTapCount (const gscaAPU* apu);
+
+/**
+ * @brief   Runs the APU for the given number of clock cycles, writing the audio
+ *          samples output by each of its output taps into that tap's buffer.
+ *
+ * The taps are always point-sampled, even if the band-limited output stage is
+ * enabled, and the APU's own sample clock is not advanced. The render stops
+ * early, just short of the cycle on which a tap's next sample is due, if that
+ * tap's buffer is full.
+ *
+ * @param   apu         A pointer to the GSCA APU emulation context.
+ * @param   out         An array of interleaved stereo buffers, one per tap.
+ * @param   frameCounts An array of sizes, one per tap. On input, the number of
+ *                      audio samples each tap's buffer has room for; on output,
+ *                      the number of audio samples written to it.
+ * @param   cycleCount  The number of clock cycles to run the APU for.
+ *
+ * @return  The number of clock cycles the APU was run for.
+ */
+GSCA_API uint64_t gscaRenderAPUTaps (gscaAPU* apu, gscaAudioSample* const* out,
+    size_t* frameCounts, uint64_t cycleCount);
+
+/**
+ * @brief   Creates a new batch of GSCA APU emulation contexts, which are run in
+ *          lock-step and rendered together with SIMD kernels.
+ *
+ * Each lane of the batch is an ordinary APU context, which can be retrieved
+ * with @a gscaGetAPUBatchLane and driven by its own audio engine. All lanes are
+ * clocked from the batch's tick counter and sample clock, and their
+ * band-limited output stages, if enabled, are not used by the batch.
+ *
+ * Likewise, a lane's own sample rate, stems and output taps are ignored. A lane
+ * which has been reset, rendered or had its sample rate changed on its own is
+ * put back in step with the batch by @a gscaRenderAPUBatch, taking on the
+ * batch's tick counter, sample clock and sample rate.
+ *
+ * @param   laneCount   The number of lanes, between `1` and
+ *                      `GSCA_APU_BATCH_LANES`.
+ *
+ * @return  A pointer to the new batch.
+ */
+GSCA_API gscaAPUBatch* gscaCreateAPUBatch (size_t laneCount);
+
+/**
+ * @brief   Destroys the given batch of GSCA APU emulation contexts, along with
+ *          each of its lanes.
+ *
+ * @param   batch   A pointer to the batch.
+ */
+GSCA_API void gscaDestroyAPUBatch (gscaAPUBatch* batch);
+
+/**
+ * @brief   Retrieves the number of lanes in the given batch.
+ *
+ * @param   batch   A pointer to the batch.
+ *
+ * @return  The number of lanes in the batch.
+ */
+GSCA_API size_t gscaGetAPUBatchLaneCount (const gscaAPUBatch* batch);
+
+/**
+ * @brief   Retrieves the APU emulation context in the given lane of a batch.
+ *
+ * The lane may be written to, read from and reset as any other APU context.
+ * It is put back in step with the batch when the batch is next rendered.
+ *
+ * @param   batch   A pointer to the batch.
+ * @param   lane    The index of the lane.
+ *
+ * @return  A pointer to the lane's APU context if the lane exists; `NULL` if
+ *          not.
+ */
+GSCA_API gscaAPU* gscaGetAPUBatchLane (gscaAPUBatch* batch, size_t lane);
+
+/**
+ * @brief   Sets the rate at which every lane of the given batch outputs audio
+ *          samples.
+ *
+ * @param   batch       A pointer to the batch.
+ * @param   sampleRate  The new sample rate, in Hz.
+ *
+ * @return  `true` if the sample rate was set; `false` if it is out of range.
+ */
+GSCA_API bool gscaSetAPUBatchSampleRate (gscaAPUBatch* batch, uint32_t sampleRate);
+
+/**
+ * @brief   Runs every lane of the given batch until the given number of audio
+ *          samples have been output, writing each lane's samples into its own
+ *          buffer.
+ *
+ * Each lane's output is identical to that of @a gscaRenderAPU on a lone APU
+ * context with the same register writes.
+ *
+ * @param   batch       A pointer to the batch.
+ * @param   out         An array of one interleaved stereo buffer per lane,
+ *                      each with room for at least `frameCount` samples.
+ * @param   frameCount  The number of audio samples to output.
+ *
+ * @return  The number of audio samples written to each buffer.
+ */
+GSCA_API size_t gscaRenderAPUBatch (gscaAPUBatch* batch, gscaAudioSample* const* out,
+    size_t frameCount);
+
 /**
  * @brief   Reads the value of hardware register `NR52`, which contains the
  *          APU's master enable and channel enable flags.
@@ -764,3 +1370,31 @@ GSCA_API void gscaWriteNR43 (gscaAPU* apu, uint8_t value);
  * @param   value   The hardware register's new value.
  */
 GSCA_API void gscaWriteNR44 (gscaAPU* apu, uint8_t value);
+
+/**
+ * @brief   Sets the value of the hardware register, or the byte of wave RAM, at
+ *          the given address.
+ *
+ * Writes to addresses which are not mapped to a register are ignored.
+ *
+ * @param   apu     A pointer to the GSCA APU emulation context.
+ * @param   address The register's address, relative to `$FF00` (see
+ *                  @a gscaAudioRegister).
+ * @param   value   The hardware register's new value.
+ */
+GSCA_API void gscaWriteRegister (gscaAPU* apu, uint8_t address, uint8_t value);
+
+/**
+ * @brief   Applies a list of register writes, in order, as if each were made
+ *          with @a gscaWriteRegister on the same clock cycle.
+ *
+ * The list is validated once, before any of it is applied. If any write in it
+ * is to an address which is not mapped to a register, none of it is applied.
+ *
+ * @param   apu     A pointer to the GSCA APU emulation context.
+ * @param   writes  A pointer to the list of register writes.
+ * @param   count   The number of writes in the list.
+ *
+ * @return  `true` if the list was applied; `false` if not.
+ */
+GSCA_API bool gscaWriteRegisters (gscaAPU* apu, const gscaRegisterWrite* writes, size_t count);
@@ -6,6 +6,7 @@
 #include <GSCA/APU.h>
 #include <GSCA/AudioStore.h>
 #include <GSCA/AudioEngine.h>
+#include <stdatomic.h>
 #define ctx engine->context
 
 /* Private Constants - Drum Instruments ***************************************/
@@ -316,7 +317,7 @@ static const uint8_t *GSCA_DRUMKIT5[] = {
 
 /* Private Constants **********************************************************/
 
-static const uint8_t** GSCA_DRUMKIT_COLLECTION[] = {
+static const uint8_t** GSCA_DRUMKIT_COLLECTION[GSCA_DRUMKIT_COUNT] = {
     GSCA_DRUMKIT0,
     GSCA_DRUMKIT1,
     GSCA_DRUMKIT2,
@@ -325,22 +326,7 @@ static const uint8_t** GSCA_DRUMKIT_COLLECTION[] = {
     GSCA_DRUMKIT5
 };
 
-#define GSCA_WAVE_SAMPLE_COUNT 10
-
-static const char GSCA_WAVE_STRINGS[GSCA_WAVE_SAMPLE_COUNT][33] = {
-    "02468ACEFFFEDDCBBA98765444332211",
-    "02468ACEEFFFFEEECCBBA98765432211",
-    "1369BDEEEEFFFFEDDEFFFFEEEEDB9631",
-    "02468ACDEFFEDEFFEEDCBA9876543210",
-    "012345678ACDEEF77FEEDCA876543210",
-    "0011223344332211FFEECCAA88AACCEE",
-    "02468ACECBA98765FFFEEDDC44332211",
-    "C0A987F5FFFEEDDC443322F102468ACE",
-    "4433221F00468ACEF8FEEDDCCBA98765",
-    "110000080013579AB4BAA99887654321"
-};
-
-static const uint16_t GSCA_FREQUENCY_TABLE[] = {
+static const uint16_t GSCA_FREQUENCY_TABLE[GSCA_FREQUENCY_COUNT] = {
     0x0000,  // __
     0XF82C,  // C_
     0XF89D,  // C#
@@ -369,6 +355,10 @@ static const uint16_t GSCA_FREQUENCY_TABLE[] = {
     0XFDED,  // B_
 };
 
+#define GSCA_AE_WRITE_LIST_SIZE         256
+#define GSCA_AE_COMMAND_QUEUE_SIZE      64
+#define GSCA_AE_SHADOW_REGISTER_COUNT   0x40
+
 /* Virtual Channel Structure **************************************************/
 
 typedef struct
@@ -449,8 +439,56 @@ typedef struct
     uint8_t     field2f;
     uint16_t    field30;
     uint8_t     unknown0f;
+    bool        verified;
 } gscaChannelStruct;
 
+/* Music Instruction Structure ************************************************/
+
+/**
+ * @brief   A music command or note, decoded from the byte at one address in the
+ *          audio store's data.
+ *
+ * Which of the bytes after the opcode a command takes as operands depends on
+ * the state of the channel running it, so each instruction keeps the next three
+ * bytes, and the branch commands keep their target address, already assembled.
+ */
+typedef struct
+{
+    uint8_t     opcode;
+    uint8_t     operands[3];
+    uint32_t    target;
+} gscaMusicInstruction;
+
+/* Engine Command Structure ***************************************************/
+
+typedef enum
+{
+    GSCA_EC_STOP_AUDIO,
+    GSCA_EC_FADE_TO_MUSIC,
+    GSCA_EC_PLAY_MUSIC,
+    GSCA_EC_PLAY_SFX,
+    GSCA_EC_PLAY_STEREO_SFX,
+    GSCA_EC_PLAY_CRY
+} gscaEngineCommandType;
+
+/**
+ * @brief   A play, fade or stop request queued from another thread, to be run by
+ *          the engine at the start of its next update.
+ *
+ * Each slot's sequence number tells producers and the consumer whose turn it is
+ * to use the slot: it equals the slot's position in the queue while the slot is
+ * free, and that position plus one once a command has been written to it.
+ */
+typedef struct
+{
+    atomic_size_t   sequence;
+    uint8_t         type;
+    uint8_t         length;
+    uint16_t        id;
+    int16_t         pitch;
+    int16_t         cryLength;
+} gscaEngineCommand;
+
 /* Audio Engine Structure *****************************************************/
 
 typedef struct gscaAudioEngine
@@ -489,10 +527,25 @@ typedef struct gscaAudioEngine
 
     gscaAPU*                    apu;
     gscaAudioStore*             store;
+    gscaMusicInstruction*       program;
+    size_t                      programSize;
     bool                        musicPlaying;
     bool                        dontPlayMapMusicOnReload;
     bool                        stereo;
     uint8_t                     mapMusic;
+    gscaRegisterWrite           writeList[GSCA_AE_WRITE_LIST_SIZE];
+    size_t                      writeCount;
+    uint64_t                    nextUpdateCycle;
+    gscaEngineCommand           commands[GSCA_AE_COMMAND_QUEUE_SIZE];
+    atomic_size_t               commandTail;
+    size_t                      commandHead;
+    bool                        seeking;
+    uint8_t                     shadowRegisters[GSCA_AE_SHADOW_REGISTER_COUNT];
+    uint64_t                    shadowWritten;
+    uint8_t                     shadowActive;
+#if defined(GSCA_PROFILE)
+    gscaCommandProfile          profile[256];
+#endif
 } gscaAudioEngine;
 
 /* Private Function Prototypes ************************************************/
@@ -511,10 +564,14 @@ static void                 gscaHandleNoise (gscaAudioEngine*);
 static void                 gscaReadNoiseSample (gscaAudioEngine*);
 static void                 gscaParseMusic (gscaAudioEngine*);
 static void                 gscaRestoreVolume (gscaAudioEngine*);
-static void                 gscaParseSoundEffect (gscaAudioEngine*);
-static void                 gscaGetNoiseSample (gscaAudioEngine*);
-static void                 gscaParseMusicCommand (gscaAudioEngine*);
-static uint8_t              gscaGetMusicByte (gscaAudioEngine*);
+static void                 gscaParseSoundEffect (gscaAudioEngine*, const gscaMusicInstruction*);
+static void                 gscaGetNoiseSample (gscaAudioEngine*, const gscaMusicInstruction*);
+static void                 gscaParseMusicCommand (gscaAudioEngine*, const gscaMusicInstruction*);
+static void                 gscaDecodeMusicData (gscaAudioEngine*);
+static const gscaMusicInstruction* gscaFetchMusicInstruction (gscaAudioEngine*,
+                                gscaChannelStruct*);
+static uint64_t             gscaAdvanceMusicAddress (const gscaAudioEngine*,
+                                const gscaChannelStruct*, uint8_t);
 static uint16_t             gscaGetFrequency (gscaAudioEngine*, uint8_t, uint8_t);
 static void                 gscaSetNoteDuration (gscaAudioEngine*, uint8_t);
 static void                 gscaSetGlobalTempo (gscaAudioEngine*, uint16_t);
@@ -531,6 +588,15 @@ static void                 gscaPlayLoadedSFX (gscaAudioEngine*, uint16_t);
 static void                 gscaPlayLoadedCry (gscaAudioEngine*, uint16_t);
 static void                 gscaClearChannels (gscaAudioEngine*);
 static void                 gscaClearChannel (gscaAudioEngine*, gscaAudioChannel);
+static void                 gscaQueueRegisterWrite (gscaAudioEngine*, uint8_t, uint8_t);
+static uint8_t              gscaPeekNR52 (const gscaAudioEngine*);
+static void                 gscaSubmitRegisterWrites (gscaAudioEngine*);
+static uint64_t             gscaRunDueUpdate (gscaAudioEngine*);
+static bool                 gscaPostEngineCommand (gscaAudioEngine*, uint8_t, const char*,
+                                uint8_t, int16_t, int16_t);
+static void                 gscaRunEngineCommands (gscaAudioEngine*);
+static void                 gscaShadowRegisterWrite (gscaAudioEngine*, uint8_t, uint8_t);
+static void                 gscaApplyShadowRegisters (gscaAudioEngine*);
 
 /* Private Functions **********************************************************/
 
@@ -559,7 +625,7 @@ void gscaMusicOff (gscaAudioEngine* engine)
 void gscaUpdateChannel (gscaAudioEngine* engine)
 {
     gscaChannelStruct* channel = gscaCurrentChannel(engine);
-    uint8_t nr52 = gscaReadNR52(engine->apu);
+    uint8_t nr52 = gscaPeekNR52(engine);
     uint8_t frequencyLow = (ctx.currentTrackFrequency & 0xFF);
     uint8_t frequencyHigh = ((ctx.currentTrackFrequency >> 8) & 0b111);
 
@@ -572,75 +638,71 @@ void gscaUpdateChannel (gscaAudioEngine* engine)
         }
         case GSCA_VC_CHAN5:
         {
-            uint8_t nr11 = gscaReadNR11(engine->apu);
-
             if (channel->pitchSweep == true)
             {
-                gscaWriteNR10(engine->apu, ctx.pitchSweep.value);
+                gscaQueueRegisterWrite(engine, GSCA_AR_NR10, ctx.pitchSweep.value);
             }
 
             if (channel->rest == true)
             {
-                gscaWriteNR52(engine->apu, nr52 & 0b10001110);
+                gscaQueueRegisterWrite(engine, GSCA_AR_NR52, nr52 & 0b10001110);
                 gscaClearChannel(engine, GSCA_AC_PULSE1);
             }
             else if (channel->noiseSampling == true)
             {
-                gscaWriteNR11(engine->apu, (nr11 & 0x3F) | ctx.currentTrackDuty);
-                gscaWriteNR12(engine->apu, ctx.currentTrackEnvelope);
-                gscaWriteNR13(engine->apu, frequencyLow);
-                gscaWriteNR14(engine->apu, frequencyHigh | 0x80);
+                gscaQueueRegisterWrite(engine, GSCA_AR_NR11, ctx.currentTrackDuty);
+                gscaQueueRegisterWrite(engine, GSCA_AR_NR12, ctx.currentTrackEnvelope);
+                gscaQueueRegisterWrite(engine, GSCA_AR_NR13, frequencyLow);
+                gscaQueueRegisterWrite(engine, GSCA_AR_NR14, frequencyHigh | 0x80);
             }
             else if (channel->freqOverride == true)
             {
-                gscaWriteNR13(engine->apu, frequencyLow);
-                gscaWriteNR14(engine->apu, frequencyHigh);
+                gscaQueueRegisterWrite(engine, GSCA_AR_NR13, frequencyLow);
+                gscaQueueRegisterWrite(engine, GSCA_AR_NR14, frequencyHigh);
 
                 if (channel->dutyOverride == true)
                 {
-                    gscaWriteNR11(engine->apu, (nr11 & 0x3F) | ctx.currentTrackDuty);
+                    gscaQueueRegisterWrite(engine, GSCA_AR_NR11, ctx.currentTrackDuty);
                 }
             }
             else if (channel->vibratoOverride == true)
             {
-                gscaWriteNR11(engine->apu, (nr11 & 0x3F) | ctx.currentTrackDuty);
-                gscaWriteNR13(engine->apu, frequencyLow);
+                gscaQueueRegisterWrite(engine, GSCA_AR_NR11, ctx.currentTrackDuty);
+                gscaQueueRegisterWrite(engine, GSCA_AR_NR13, frequencyLow);
             }
             else if (channel->dutyOverride == true)
             {
-                gscaWriteNR11(engine->apu, (nr11 & 0x3F) | ctx.currentTrackDuty);
+                gscaQueueRegisterWrite(engine, GSCA_AR_NR11, ctx.currentTrackDuty);
             }
         } break;
         case GSCA_VC_CHAN2:
         case GSCA_VC_CHAN6:
         {
-            uint8_t nr21 = gscaReadNR21(engine->apu);
-
             if (channel->rest == true)
             {
-                gscaWriteNR52(engine->apu, nr52 & 0b10001101);
+                gscaQueueRegisterWrite(engine, GSCA_AR_NR52, nr52 & 0b10001101);
                 gscaClearChannel(engine, GSCA_AC_PULSE2);
             }
             else if (channel->noiseSampling == true)
             {
-                gscaWriteNR21(engine->apu, (nr21 & 0x3F) | ctx.currentTrackDuty);
-                gscaWriteNR22(engine->apu, ctx.currentTrackEnvelope);
-                gscaWriteNR23(engine->apu, frequencyLow);
-                gscaWriteNR24(engine->apu, frequencyHigh | 0x80);
+                gscaQueueRegisterWrite(engine, GSCA_AR_NR21, ctx.currentTrackDuty);
+                gscaQueueRegisterWrite(engine, GSCA_AR_NR22, ctx.currentTrackEnvelope);
+                gscaQueueRegisterWrite(engine, GSCA_AR_NR23, frequencyLow);
+                gscaQueueRegisterWrite(engine, GSCA_AR_NR24, frequencyHigh | 0x80);
             }
             else if (channel->freqOverride == true)
             {
-                gscaWriteNR23(engine->apu, frequencyLow);
-                gscaWriteNR24(engine->apu, frequencyHigh);
+                gscaQueueRegisterWrite(engine, GSCA_AR_NR23, frequencyLow);
+                gscaQueueRegisterWrite(engine, GSCA_AR_NR24, frequencyHigh);
             }
             else if (channel->vibratoOverride == true)
             {
-                gscaWriteNR21(engine->apu, (nr21 & 0x3F) | ctx.currentTrackDuty);
-                gscaWriteNR23(engine->apu, frequencyLow);
+                gscaQueueRegisterWrite(engine, GSCA_AR_NR21, ctx.currentTrackDuty);
+                gscaQueueRegisterWrite(engine, GSCA_AR_NR23, frequencyLow);
             }
             else if (channel->dutyOverride == true)
             {
-                gscaWriteNR21(engine->apu, (nr21 & 0x3F) | ctx.currentTrackDuty);
+                gscaQueueRegisterWrite(engine, GSCA_AR_NR21, ctx.currentTrackDuty);
             }
         } break;
         case GSCA_VC_CHAN3:
@@ -648,29 +710,32 @@ void gscaUpdateChannel (gscaAudioEngine* engine)
         {
             if (channel->rest == true)
             {
-                gscaWriteNR52(engine->apu, nr52 & 0b10001011);
+                gscaQueueRegisterWrite(engine, GSCA_AR_NR52, nr52 & 0b10001011);
                 gscaClearChannel(engine, GSCA_AC_WAVE);
             }
             else if (channel->noiseSampling == true)
             {
-                gscaWriteNR31(engine->apu, 0x3F);
+                gscaQueueRegisterWrite(engine, GSCA_AR_NR31, 0x3F);
                 {
-                    gscaWriteNR30(engine->apu, 0x00);
-                    gscaSetWavePattern(
-                        engine->apu, 
-                        GSCA_WAVE_STRINGS[
-                            (ctx.currentTrackEnvelope & 0xF) % 
-                                GSCA_WAVE_SAMPLE_COUNT
-                    ]);
-                    gscaWriteNR32(engine->apu, (ctx.currentTrackEnvelope & 0x30) << 1);
-                    gscaWriteNR30(engine->apu, 0x80);
+                    gscaQueueRegisterWrite(engine, GSCA_AR_NR30, 0x00);
+                    const uint8_t* pattern = gscaGetWavePattern(
+                        engine->apu,
+                        (ctx.currentTrackEnvelope & 0xF) %
+                            gscaGetWaveBankSize(engine->apu)
+                    );
+                    for (uint8_t i = 0; i < GSCA_WAVE_RAM_SIZE; ++i)
+                    {
+                        gscaQueueRegisterWrite(engine, GSCA_AR_WAVE_RAM + i, pattern[i]);
+                    }
+                    gscaQueueRegisterWrite(engine, GSCA_AR_NR32, (ctx.currentTrackEnvelope & 0x30) << 1);
+                    gscaQueueRegisterWrite(engine, GSCA_AR_NR30, 0x80);
                 }
-                gscaWriteNR33(engine->apu, frequencyLow);
-                gscaWriteNR34(engine->apu, frequencyHigh | 0x80);
+                gscaQueueRegisterWrite(engine, GSCA_AR_NR33, frequencyLow);
+                gscaQueueRegisterWrite(engine, GSCA_AR_NR34, frequencyHigh | 0x80);
             }
             else if (channel->vibratoOverride == true)
             {
-                gscaWriteNR33(engine->apu, frequencyLow);
+                gscaQueueRegisterWrite(engine, GSCA_AR_NR33, frequencyLow);
             }
         } break;
         case GSCA_VC_CHAN4:
@@ -678,15 +743,15 @@ void gscaUpdateChannel (gscaAudioEngine* engine)
         {
             if (channel->rest == true)
             {
-                gscaWriteNR52(engine->apu, nr52 & 0b10000111);
+                gscaQueueRegisterWrite(engine, GSCA_AR_NR52, nr52 & 0b10000111);
                 gscaClearChannel(engine, GSCA_AC_NOISE);
             }
             else if (channel->noiseSampling == true)
             {
-                gscaWriteNR41(engine->apu, 0x3F);
-                gscaWriteNR42(engine->apu, ctx.currentTrackEnvelope);
-                gscaWriteNR43(engine->apu, frequencyLow);
-                gscaWriteNR44(engine->apu, 0x80);
+                gscaQueueRegisterWrite(engine, GSCA_AR_NR41, 0x3F);
+                gscaQueueRegisterWrite(engine, GSCA_AR_NR42, ctx.currentTrackEnvelope);
+                gscaQueueRegisterWrite(engine, GSCA_AR_NR43, frequencyLow);
+                gscaQueueRegisterWrite(engine, GSCA_AR_NR44, 0x80);
             }
         } break;
     }
@@ -702,11 +767,11 @@ void gscaPlayDangerTone (gscaAudioEngine* engine)
         if (alarm->counter == 0)
         {
             uint16_t pitch = (alarm->pitch == true) ? 0x750 : 0x6EE;
-            gscaWriteNR10(engine->apu, 0x00);
-            gscaWriteNR11(engine->apu, 0x80);
-            gscaWriteNR12(engine->apu, 0xE2);
-            gscaWriteNR13(engine->apu, pitch & 0xFF);
-            gscaWriteNR14(engine->apu, (pitch >> 8) | 0x80);
+            gscaQueueRegisterWrite(engine, GSCA_AR_NR10, 0x00);
+            gscaQueueRegisterWrite(engine, GSCA_AR_NR11, 0x80);
+            gscaQueueRegisterWrite(engine, GSCA_AR_NR12, 0xE2);
+            gscaQueueRegisterWrite(engine, GSCA_AR_NR13, pitch & 0xFF);
+            gscaQueueRegisterWrite(engine, GSCA_AR_NR14, (pitch >> 8) | 0x80);
         }
 
         if (++alarm->counter == 0)
@@ -1036,15 +1101,14 @@ void gscaParseMusic (gscaAudioEngine* engine)
 {
     gscaChannelStruct* channel = gscaCurrentChannel(engine);
 
-	// Keep track of the next music command.
-	uint8_t musicCommand = 0x00;
-
-	// Loop, parsing bytes until a note is read, or the current music song ends.
+	// Loop, running instructions until a note is read, or the current music
+	// song ends.
 	while (true)
 	{
 
-		// Parse the next music command and place it here.
-		musicCommand = gscaGetMusicByte(engine);
+		// Fetch the next decoded instruction.
+		const gscaMusicInstruction* instruction = gscaFetchMusicInstruction(engine, channel);
+		uint8_t musicCommand = instruction->opcode;
 
 		// If the next command is a `SOUND_RET` command, and a music subroutine
 		// is not currently being processed, then we can assume that the end of
@@ -1076,7 +1140,7 @@ void gscaParseMusic (gscaAudioEngine* engine)
 
 				if (ctx.currentChannelIndex == GSCA_VC_SFX1)
 				{
-					gscaWriteNR10(engine->apu, 0x00);
+					gscaQueueRegisterWrite(engine, GSCA_AR_NR10, 0x00);
 				}
 
 			}
@@ -1100,13 +1164,13 @@ void gscaParseMusic (gscaAudioEngine* engine)
 				channel->cry == 1
 			)
 			{
-				gscaParseSoundEffect(engine);
+				gscaParseSoundEffect(engine, instruction);
 			}
 
 			// Is this channel processing noise?
 			else if (channel->noise == 1)
 			{
-				gscaGetNoiseSample(engine);
+				gscaGetNoiseSample(engine, instruction);
 			}
 
 			// Otherwise, we are processing a music note.
@@ -1114,10 +1178,10 @@ void gscaParseMusic (gscaAudioEngine* engine)
 			{
 
 				// The lower nibble of the music command byte is the note's duration.
-				gscaSetNoteDuration(engine, ctx.currentMusicByte & 0xF);
+				gscaSetNoteDuration(engine, musicCommand & 0xF);
 
 				// The upper nibble of the command byte is the note.
-				uint8_t note = ctx.currentMusicByte >> 4;
+				uint8_t note = musicCommand >> 4;
 
 				// A note value of zero indicates a rest. If this is encountered, then set
 				// the channel's rest flag.
@@ -1146,7 +1210,18 @@ void gscaParseMusic (gscaAudioEngine* engine)
 		// This has to be a music command. Parse it and continue in the loop.
 		else
 		{
-			gscaParseMusicCommand(engine);
+#if defined(GSCA_PROFILE)
+			struct timespec start, end;
+			timespec_get(&start, TIME_UTC);
+			gscaParseMusicCommand(engine, instruction);
+			timespec_get(&end, TIME_UTC);
+
+			engine->profile[musicCommand].count++;
+			engine->profile[musicCommand].nanoseconds +=
+				(end.tv_sec - start.tv_sec) * 1000000000ll + (end.tv_nsec - start.tv_nsec);
+#else
+			gscaParseMusicCommand(engine, instruction);
+#endif
 		}
 
 	}
@@ -1172,35 +1247,39 @@ void gscaRestoreVolume (gscaAudioEngine* engine)
 	}
 }
 
-void gscaParseSoundEffect (gscaAudioEngine* engine)
+void gscaParseSoundEffect (gscaAudioEngine* engine, const gscaMusicInstruction* instruction)
 {
     gscaChannelStruct* channel = gscaCurrentChannel(engine);
 
 	// Enable noise sampling for this channel.
 	channel->noiseSampling = 1;
 
-	// Set the next note's duration according to the current music byte.
-	gscaSetNoteDuration(engine, ctx.currentMusicByte);
+	// Set the next note's duration according to the instruction's opcode.
+	gscaSetNoteDuration(engine, instruction->opcode);
 
-	// The next music byte should contain the note's volume envelope setting.
-	channel->volumeEnvelope = gscaGetMusicByte(engine);
+	// The first operand should contain the note's volume envelope setting.
+	channel->volumeEnvelope = instruction->operands[0];
 
-	// The next music byte (or two music bytes for the non-noise channels) should
+	// The next operand (or two operands for the non-noise channels) should
 	// contain the next frequency.
-	uint16_t frequency = gscaGetMusicByte(engine);
+	uint16_t frequency = instruction->operands[1];
+	uint8_t length = 2;
 	if (
 		ctx.currentChannelIndex != GSCA_VC_CHAN4 &&
 		ctx.currentChannelIndex != GSCA_VC_CHAN8
 	)
 	{
-		frequency |= (gscaGetMusicByte(engine) << 8);
+		frequency |= (instruction->operands[2] << 8);
+		length = 3;
 	}
 
+	channel->musicAddress = gscaAdvanceMusicAddress(engine, channel, length);
+
 	// Update the channel's frequency.
 	channel->frequency = frequency;
 }
 
-void gscaGetNoiseSample (gscaAudioEngine* engine)
+void gscaGetNoiseSample (gscaAudioEngine* engine, const gscaMusicInstruction* instruction)
 {
 	// This function does nothing if we are not working one of the noise channels
 	// (`CHAN4` or `CHAN8`).
@@ -1210,9 +1289,8 @@ void gscaGetNoiseSample (gscaAudioEngine* engine)
 	)
 	{
 
-		// The new note duration should be in the low nibble of the current
-		// music byte.
-		gscaSetNoteDuration(engine, ctx.currentMusicByte & 0xF);
+		// The new note duration should be in the low nibble of the opcode.
+		gscaSetNoteDuration(engine, instruction->opcode & 0xF);
 
 		// Keep the proper sample index here.
 		uint8_t sampleIndex = 0;
@@ -1233,8 +1311,8 @@ void gscaGetNoiseSample (gscaAudioEngine* engine)
 			sampleIndex = ctx.musicNoiseSampleSet;
 		}
 
-		// Get the note from the upper nibble of the music byte.
-		uint8_t note = (ctx.currentMusicByte >> 4);
+		// Get the note from the upper nibble of the opcode.
+		uint8_t note = (instruction->opcode >> 4);
 
 		// If the note is not a rest note, then use the above-calculated sample
 		// index and note values to index the correct drum instrument.
@@ -1249,14 +1327,16 @@ void gscaGetNoiseSample (gscaAudioEngine* engine)
 	}
 }
 
-void gscaParseMusicCommand (gscaAudioEngine* engine)
+void gscaParseMusicCommand (gscaAudioEngine* engine, const gscaMusicInstruction* instruction)
 {
     gscaChannelStruct* channel = gscaCurrentChannel(engine);
 
-	// The current music byte should contain the opcode of the music command.
-	uint8_t opcode = ctx.currentMusicByte;
+	// The instruction's opcode selects the music command. Most commands take a
+	// fixed number of operands, which are skipped over once it has run.
+	const uint8_t* operands = instruction->operands;
+	uint8_t length = 0;
 
-	switch (opcode)
+	switch (instruction->opcode)
 	{
 		case GSCA_OCTAVE_CMD0:
 		case GSCA_OCTAVE_CMD1:
@@ -1267,47 +1347,53 @@ void gscaParseMusicCommand (gscaAudioEngine* engine)
 		case GSCA_OCTAVE_CMD6:
 		case GSCA_OCTAVE_CMD7:
 		{
-			channel->octave = ctx.currentMusicByte & 0b111;
+			channel->octave = instruction->opcode & 0b111;
 		} break;
 		case GSCA_NOTE_TYPE_CMD:
 		{
-			channel->noteLength = gscaGetMusicByte(engine);
+			channel->noteLength = operands[0];
+			length = 1;
 			if ((ctx.currentChannelIndex & 0b11) < GSCA_VC_CHAN4)
 			{
-				channel->volumeEnvelope = gscaGetMusicByte(engine);
+				channel->volumeEnvelope = operands[1];
+				length = 2;
 			}
 		} break;
 		case GSCA_TRANSPOSE_CMD:
 		{
-			channel->transposition = gscaGetMusicByte(engine);
+			channel->transposition = operands[0];
+			length = 1;
 		} break;
 		case GSCA_TEMPO_CMD:
 		{
-			uint16_t high = gscaGetMusicByte(engine);
-			uint16_t low  = gscaGetMusicByte(engine);
-			gscaSetGlobalTempo(engine, (high << 8) | low);
+			gscaSetGlobalTempo(engine, (operands[0] << 8) | operands[1]);
+			length = 2;
 		} break;
 		case GSCA_DUTY_CYCLE_CMD:
 		{
-			channel->dutyCycle = (gscaGetMusicByte(engine) << 6);
+			channel->dutyCycle = (operands[0] << 6);
+			length = 1;
 		} break;
 		case GSCA_VOLUME_ENVELOPE_CMD:
 		{
-			channel->volumeEnvelope = gscaGetMusicByte(engine);
+			channel->volumeEnvelope = operands[0];
+			length = 1;
 		} break;
 		case GSCA_PITCH_SWEEP_CMD:
 		{
-			ctx.pitchSweep.value = gscaGetMusicByte(engine);
+			ctx.pitchSweep.value = operands[0];
 			channel->pitchSweep = 1;
+			length = 1;
 		} break;
 		case GSCA_DUTY_CYCLE_PATTERN_CMD:
 		{
 			channel->dutyLoop = 1;
-			channel->dutyCyclePattern = gscaGetMusicByte(engine);
+			channel->dutyCyclePattern = operands[0];
 			channel->dutyCyclePattern =
 				(channel->dutyCyclePattern << 2) |
 				(channel->dutyCyclePattern >> 6);
 			channel->dutyCycle = (channel->dutyCyclePattern & 0b11000000);
+			length = 1;
 		} break;
 		case GSCA_TOGGLE_SFX_CMD:
 		{
@@ -1315,59 +1401,61 @@ void gscaParseMusicCommand (gscaAudioEngine* engine)
 		} break;
 		case GSCA_PITCH_SLIDE_CMD:
 		{
-			ctx.currentNoteDuration = gscaGetMusicByte(engine);
-			uint8_t note = gscaGetMusicByte(engine);
+			ctx.currentNoteDuration = operands[0];
+			uint8_t note = operands[1];
 
 			channel->pitchSlideTarget = gscaGetFrequency(engine, note & 0xF, note >> 4);
 			channel->pitchSlide = 1;
+			length = 2;
 		} break;
 		case GSCA_VIBRATO_CMD:
 		{
 			channel->vibrato = 1;
 			channel->vibratoDir = 0;
-			channel->vibratoDelay = gscaGetMusicByte(engine);
+			channel->vibratoDelay = operands[0];
 			channel->vibratoDelayCount = channel->vibratoDelay;
 
-			uint8_t param = gscaGetMusicByte(engine);
+			uint8_t param = operands[1];
 			channel->vibratoRate = (param & 0xF);
 			channel->vibratoRate |= (channel->vibratoRate << 4);
 
 			param >>= 4;
 			channel->vibratoExtent = (param >> 1);
 			channel->vibratoExtent |= ((channel->vibratoExtent + (param & 1)) << 4);
+			length = 2;
 		} break;
 		case GSCA_TOGGLE_NOISE_CMD:
 		{
 			channel->noise ^= 1;
 			if (channel->noise == 1)
 			{
-				ctx.musicNoiseSampleSet = gscaGetMusicByte(engine);
+				ctx.musicNoiseSampleSet = operands[0];
+				length = 1;
 			}
 		} break;
 		case GSCA_FORCE_STEREO_PANNING_CMD:
 		{
 			gscaSetLRTracks(engine, ctx.currentChannelIndex);
-			channel->tracks &= gscaGetMusicByte(engine);
+			channel->tracks &= operands[0];
+			length = 1;
 		} break;
 		case GSCA_VOLUME_CMD:
 		{
-			uint8_t param = gscaGetMusicByte(engine);
 			if (ctx.musicFade.value == 0)
 			{
-				ctx.volume.value = param;
+				ctx.volume.value = operands[0];
 			}
+			length = 1;
 		} break;
 		case GSCA_PITCH_OFFSET_CMD:
 		{
-			uint16_t high = gscaGetMusicByte(engine);
-			uint16_t low  = gscaGetMusicByte(engine);
-
 			channel->pitchOffsetEnabled = 1;
-			channel->pitchOffset = (high << 8) | low;
+			channel->pitchOffset = (operands[0] << 8) | operands[1];
+			length = 2;
 		} break;
 		case GSCA_TEMPO_RELATIVE_CMD:
 		{
-			uint8_t param = gscaGetMusicByte(engine);
+			uint8_t param = operands[0];
 			if (param & 0x80)
 			{
 				gscaSetGlobalTempo(engine, channel->tempo - (param & 0x7F));
@@ -1376,18 +1464,13 @@ void gscaParseMusicCommand (gscaAudioEngine* engine)
 			{
 				gscaSetGlobalTempo(engine, channel->tempo + param);
 			}
+			length = 1;
 		} break;
 		case GSCA_RESTART_CHANNEL_CMD:
-		{
-			// Ignore this command; skip over its word parameter.
-			gscaGetMusicByte(engine);
-			gscaGetMusicByte(engine);
-		} break;
 		case GSCA_NEW_SONG_CMD:
 		{
-			// Ignore this command; skip over its word parameter.
-			gscaGetMusicByte(engine);
-			gscaGetMusicByte(engine);
+			// Ignore these commands; skip over their word parameter.
+			length = 2;
 		} break;
 		case GSCA_SFX_PRIORITY_ON_CMD:
 		{
@@ -1403,96 +1486,44 @@ void gscaParseMusicCommand (gscaAudioEngine* engine)
 			if (engine->stereo == true)
 			{
 				gscaSetLRTracks(engine, ctx.currentChannelIndex);
-				channel->tracks &= gscaGetMusicByte(engine);
-			}
-			else
-			{
-				gscaGetMusicByte(engine);
+				channel->tracks &= operands[0];
 			}
+			length = 1;
 		} break;
 		case GSCA_SFX_TOGGLE_NOISE_CMD:
 		{
 			channel->noise ^= 1;
 			if (channel->noise == 1)
 			{
-				ctx.sfxNoiseSampleSet = gscaGetMusicByte(engine);
+				ctx.sfxNoiseSampleSet = operands[0];
+				length = 1;
 			}
 		} break;
 		case GSCA_SET_CONDITION_CMD:
 		{
-			channel->condition = gscaGetMusicByte(engine);
+			channel->condition = operands[0];
+			length = 1;
 		} break;
 		case GSCA_SOUND_JUMP_IF_CMD:
 		{
-			if (gscaGetMusicByte(engine) == channel->condition)
-			{
-                uint64_t    byte0 = gscaGetMusicByte(engine),
-                            byte1 = gscaGetMusicByte(engine),
-                            byte2 = gscaGetMusicByte(engine),
-                            byte3 = gscaGetMusicByte(engine),
-                            byte4 = gscaGetMusicByte(engine),
-                            byte5 = gscaGetMusicByte(engine),
-                            byte6 = gscaGetMusicByte(engine),
-                            byte7 = gscaGetMusicByte(engine);
-                channel->musicAddress =
-                    (byte0 <<  0) |
-                    (byte1 <<  8) |
-                    (byte2 << 16) |
-                    (byte3 << 24) |
-                    (byte4 << 32) |
-                    (byte5 << 40) |
-                    (byte6 << 48) |
-                    (byte7 << 56);
-			}
-			else
-			{	
-				channel->musicAddress += 8;
-			}
+			// A branch not taken skips the target address without wrapping it;
+			// the next fetch does that.
+			channel->musicAddress = (operands[0] == channel->condition)
+				? instruction->target
+				: gscaAdvanceMusicAddress(engine, channel, 1) + 8;
 		} break;
 		case GSCA_SOUND_JUMP_CMD:
 		{
-            uint64_t    byte0 = gscaGetMusicByte(engine),
-                        byte1 = gscaGetMusicByte(engine),
-                        byte2 = gscaGetMusicByte(engine),
-                        byte3 = gscaGetMusicByte(engine),
-                        byte4 = gscaGetMusicByte(engine),
-                        byte5 = gscaGetMusicByte(engine),
-                        byte6 = gscaGetMusicByte(engine),
-                        byte7 = gscaGetMusicByte(engine);
-            channel->musicAddress =
-                (byte0 <<  0) |
-                (byte1 <<  8) |
-                (byte2 << 16) |
-                (byte3 << 24) |
-                (byte4 << 32) |
-                (byte5 << 40) |
-                (byte6 << 48) |
-                (byte7 << 56);
+			channel->musicAddress = instruction->target;
 		} break;
 		case GSCA_SOUND_LOOP_CMD:
 		{
-			uint8_t loop_count = gscaGetMusicByte(engine);
+			uint8_t loop_count = operands[0];
 			if (channel->looping == 0)
 			{
 				if (loop_count == 0)
-                {
-                    uint64_t    byte0 = gscaGetMusicByte(engine),
-                                byte1 = gscaGetMusicByte(engine),
-                                byte2 = gscaGetMusicByte(engine),
-                                byte3 = gscaGetMusicByte(engine),
-                                byte4 = gscaGetMusicByte(engine),
-                                byte5 = gscaGetMusicByte(engine),
-                                byte6 = gscaGetMusicByte(engine),
-                                byte7 = gscaGetMusicByte(engine);
-                    channel->musicAddress =
-                        (byte0 <<  0) |
-                        (byte1 <<  8) |
-                        (byte2 << 16) |
-                        (byte3 << 24) |
-                        (byte4 << 32) |
-                        (byte5 << 40) |
-                        (byte6 << 48) |
-                        (byte7 << 56);
+				{
+					channel->musicAddress = instruction->target;
 					break;
 				}
 
@@ -1504,51 +1535,20 @@ void gscaParseMusicCommand (gscaAudioEngine* engine)
 			{
 				channel->looping = 0;
 				channel->loopCount = 0;
-				channel->musicAddress += 8;
+				channel->musicAddress =
+					gscaAdvanceMusicAddress(engine, channel, 1) + 8;
 			}
 			else
 			{
-                uint64_t    byte0 = gscaGetMusicByte(engine),
-                            byte1 = gscaGetMusicByte(engine),
-                            byte2 = gscaGetMusicByte(engine),
-                            byte3 = gscaGetMusicByte(engine),
-                            byte4 = gscaGetMusicByte(engine),
-                            byte5 = gscaGetMusicByte(engine),
-                            byte6 = gscaGetMusicByte(engine),
-                            byte7 = gscaGetMusicByte(engine);
-                channel->musicAddress =
-                    (byte0 <<  0) |
-                    (byte1 <<  8) |
-                    (byte2 << 16) |
-                    (byte3 << 24) |
-                    (byte4 << 32) |
-                    (byte5 << 40) |
-                    (byte6 << 48) |
-                    (byte7 << 56);
+				channel->musicAddress = instruction->target;
 				channel->loopCount--;
 			}
 		} break;
 		case GSCA_SOUND_CALL_CMD:
 		{
-            uint64_t    byte0 = gscaGetMusicByte(engine),
-                        byte1 = gscaGetMusicByte(engine),
-                        byte2 = gscaGetMusicByte(engine),
-                        byte3 = gscaGetMusicByte(engine),
-                        byte4 = gscaGetMusicByte(engine),
-                        byte5 = gscaGetMusicByte(engine),
-                        byte6 = gscaGetMusicByte(engine),
-                        byte7 = gscaGetMusicByte(engine);
-            channel->lastMusicAddress = (channel->musicAddress);
-            channel->musicAddress =
-                (byte0 <<  0) |
-                (byte1 <<  8) |
-                (byte2 << 16) |
-                (byte3 << 24) |
-                (byte4 << 32) |
-                (byte5 << 40) |
-                (byte6 << 48) |
-                (byte7 << 56);
-
+			channel->lastMusicAddress =
+				gscaAdvanceMusicAddress(engine, channel, 8);
+			channel->musicAddress = instruction->target;
 			channel->subroutine = 1;
 		} break;
 		case GSCA_SOUND_RET_CMD:
@@ -1558,30 +1558,105 @@ void gscaParseMusicCommand (gscaAudioEngine* engine)
 		} break;
 		default: break;
 	}
+
+	if (length > 0)
+	{
+		channel->musicAddress =
+			gscaAdvanceMusicAddress(engine, channel, length);
+	}
 }
 
-uint8_t gscaGetMusicByte (gscaAudioEngine* engine)
+void gscaDecodeMusicData (gscaAudioEngine* engine)
 {
-    // Read from the engine's data store's buffer at the current music address.
-    // Place the byat that was read into the engine context's current music byte.
-    const uint64_t size = gscaGetAudioDataSize(engine->store);
-    if (size == 0)
+    // The decoded program is only rebuilt when the audio store's data has
+    // grown; its existing bytes never change.
+    const size_t size = gscaGetAudioDataSize(engine->store);
+    if (size == engine->programSize)
     {
-        ctx.currentMusicByte = 0;
+        return;
     }
-    else
+
+    gscaExpect(size <= UINT32_MAX, "Audio data is too large to decode (%zu bytes).\n", size);
+    gscaMusicInstruction* program = gscaResize(engine->program, size, gscaMusicInstruction);
+    gscaExpectp(program, "Could not allocate decoded music program");
+    engine->program = program;
+    engine->programSize = size;
+
+    // Decode an instruction at every address, since a branch may land on any
+    // of them. Reads past the end of the data wrap around to its start, as
+    // the channels' own reads do.
+    const uint8_t* data = gscaGetAudioData(engine->store);
+    for (size_t address = 0; address < size; ++address)
     {
-        gscaChannelStruct* channel = gscaCurrentChannel(engine);
-        const uint8_t* data = gscaGetAudioData(engine->store);
-        if (channel->musicAddress >= size)
+        gscaMusicInstruction* instruction = &program[address];
+        instruction->opcode = data[address];
+        for (size_t i = 0; i < 3; ++i)
         {
-            channel->musicAddress = 0;
+            instruction->operands[i] = data[(address + 1 + i) % size];
         }
 
-        ctx.currentMusicByte = data[channel->musicAddress++];
+        size_t pointer = 0;
+        switch (instruction->opcode)
+        {
+            case GSCA_SOUND_JUMP_CMD:
+            case GSCA_SOUND_CALL_CMD:       pointer = address + 1; break;
+            case GSCA_SOUND_JUMP_IF_CMD:
+            case GSCA_SOUND_LOOP_CMD:       pointer = address + 2; break;
+            default:                        instruction->target = 0; continue;
+        }
+
+        // Targets outside of the data resolve to its start, where the first
+        // fetch from them would land.
+        uint64_t target = 0;
+        for (size_t i = 0; i < 8; ++i)
+        {
+            target |= (uint64_t) data[(pointer + i) % size] << (i * 8);
+        }
+        instruction->target = (target < size) ? (uint32_t) target : 0;
     }
+}
 
-    return ctx.currentMusicByte;
+const gscaMusicInstruction* gscaFetchMusicInstruction (gscaAudioEngine* engine,
+    gscaChannelStruct* channel)
+{
+    // An empty audio store reads as zeroes, without moving the channel along.
+    static const gscaMusicInstruction EMPTY = { 0 };
+    if (engine->programSize == 0)
+    {
+        return &EMPTY;
+    }
+
+    // The bytecode of a verified channel never leaves the audio store's data,
+    // so only an unverified one needs its address checked.
+    uint64_t address = channel->musicAddress;
+    if (channel->verified == false && address >= engine->programSize)
+    {
+        address = 0;
+    }
+
+    channel->musicAddress = address + 1;
+    return &engine->program[address];
+}
+
+uint64_t gscaAdvanceMusicAddress (const gscaAudioEngine* engine,
+    const gscaChannelStruct* channel, uint8_t count)
+{
+    // Skips the given number of operand bytes after a fetch, wrapping around as
+    // reading them one at a time would.
+    uint64_t address = channel->musicAddress;
+    if (engine->programSize == 0)
+    {
+        return address;
+    }
+    else if (channel->verified == true)
+    {
+        return address + count;
+    }
+
+    address += count;
+    return (address <= engine->programSize)
+        ? address
+        : ((address - 1) % engine->programSize) + 1;
 }
 
 uint16_t gscaGetFrequency (gscaAudioEngine* engine, uint8_t note, uint8_t octave)
@@ -1680,7 +1755,8 @@ void gscaPlayStereoLoadedSFX (gscaAudioEngine* engine, uint16_t id)
 
     // Set the music ID, then get its offset.
     ctx.musicId = id;
-    uint64_t cursor = gscaGetHandleByID(engine->store, ctx.musicId)->offset;
+    const gscaAudioHandle* handle = gscaGetHandleByID(engine->store, ctx.musicId);
+    uint64_t cursor = handle->offset;
 
 	// The first byte of the music header should be at address $0000. Load it.
 	uint8_t firstByte = gscaLoadMusicByte(engine, cursor);
@@ -1696,6 +1772,7 @@ void gscaPlayStereoLoadedSFX (gscaAudioEngine* engine, uint16_t id)
 		cursor = gscaLoadChannel(engine, cursor);
         gscaChannelStruct* channel = gscaCurrentChannel(engine);
 		channel->sfx = 1;
+		channel->verified = (handle->verified & GSCA_AV_SFX) != 0;
 		gscaStartChannel(engine);
 
         // Configure panning settings for this channel.
@@ -1820,7 +1897,8 @@ void gscaPlayLoadedMusic (gscaAudioEngine* engine, uint16_t id)
     ctx.musicId = id;
     
     // Keep track of a memory cursor.
-    uint64_t cursor = gscaGetHandleByID(engine->store, ctx.musicId)->offset;
+    const gscaAudioHandle* handle = gscaGetHandleByID(engine->store, ctx.musicId);
+    uint64_t cursor = handle->offset;
 
 	// The first byte of the music header should be at address $0000. Load it.
 	uint8_t firstByte = gscaLoadMusicByte(engine, cursor);
@@ -1830,6 +1908,7 @@ void gscaPlayLoadedMusic (gscaAudioEngine* engine, uint16_t id)
 	for (uint8_t i = 0; i <= channelCount; ++i)
 	{
 		cursor = gscaLoadChannel(engine, cursor);
+		gscaCurrentChannel(engine)->verified = (handle->verified & GSCA_AV_MUSIC) != 0;
 		gscaStartChannel(engine);
 	}
 
@@ -1888,7 +1967,8 @@ void gscaPlayLoadedSFX (gscaAudioEngine* engine, uint16_t id)
 	ctx.musicId = id;
 
 	// Keep track of a memory cursor.
-	uint64_t cursor = gscaGetHandleByID(engine->store, ctx.musicId)->offset;
+	const gscaAudioHandle* handle = gscaGetHandleByID(engine->store, ctx.musicId);
+	uint64_t cursor = handle->offset;
 
 	// The first byte of the music header should be at address $0000. Load it.
 	uint8_t firstByte = gscaLoadMusicByte(engine, cursor);
@@ -1901,6 +1981,7 @@ void gscaPlayLoadedSFX (gscaAudioEngine* engine, uint16_t id)
 	{
 		cursor = gscaLoadChannel(engine, cursor);
 		ctx.channels[ctx.currentChannelIndex].sfx = 1;
+		ctx.channels[ctx.currentChannelIndex].verified = (handle->verified & GSCA_AV_SFX) != 0;
 		gscaStartChannel(engine);
 	}
 
@@ -1918,7 +1999,8 @@ void gscaPlayLoadedCry (gscaAudioEngine* engine, uint16_t id)
 	ctx.musicId = id;
 
 	// Keep track of a memory cursor.
-	uint64_t cursor = gscaGetHandleByID(engine->store, ctx.musicId)->offset;
+	const gscaAudioHandle* handle = gscaGetHandleByID(engine->store, ctx.musicId);
+	uint64_t cursor = handle->offset;
 
 	// The first byte of the music header should be at address $0000. Load it.
 	uint8_t firstByte = gscaLoadMusicByte(engine, cursor);
@@ -1936,6 +2018,7 @@ void gscaPlayLoadedCry (gscaAudioEngine* engine, uint16_t id)
 		// Set the channel's cry and pitch offset flags.
 		channel->cry = 1;
 		channel->pitchOffsetEnabled = 1;
+		channel->verified = (handle->verified & GSCA_AV_CRY) != 0;
 		channel->pitchOffset = ctx.cryPitch;
 
 		// Set tempo for this channel if it's not a noise channel.
@@ -1967,9 +2050,9 @@ void gscaPlayLoadedCry (gscaAudioEngine* engine, uint16_t id)
 
 void gscaClearChannels (gscaAudioEngine* engine)
 {
-    gscaWriteNR52(engine->apu, 0x80);
-    gscaWriteNR51(engine->apu, 0x00);
-    gscaWriteNR50(engine->apu, 0x00);
+    gscaQueueRegisterWrite(engine, GSCA_AR_NR52, 0x80);
+    gscaQueueRegisterWrite(engine, GSCA_AR_NR51, 0x00);
+    gscaQueueRegisterWrite(engine, GSCA_AR_NR50, 0x00);
     gscaClearChannel(engine, GSCA_AC_PULSE1);
     gscaClearChannel(engine, GSCA_AC_PULSE2);
     gscaClearChannel(engine, GSCA_AC_WAVE);
@@ -1981,31 +2064,315 @@ void gscaClearChannel (gscaAudioEngine* engine, gscaAudioChannel channel)
     switch (channel)
     {
         case GSCA_AC_PULSE1:
-            gscaWriteNR10(engine->apu, 0x00);
-            gscaWriteNR11(engine->apu, 0x00);
-            gscaWriteNR12(engine->apu, 0x08);
-            gscaWriteNR13(engine->apu, 0x00);
-            gscaWriteNR14(engine->apu, 0x80);
+            gscaQueueRegisterWrite(engine, GSCA_AR_NR10, 0x00);
+            gscaQueueRegisterWrite(engine, GSCA_AR_NR11, 0x00);
+            gscaQueueRegisterWrite(engine, GSCA_AR_NR12, 0x08);
+            gscaQueueRegisterWrite(engine, GSCA_AR_NR13, 0x00);
+            gscaQueueRegisterWrite(engine, GSCA_AR_NR14, 0x80);
             break;
         case GSCA_AC_PULSE2:
-            gscaWriteNR21(engine->apu, 0x00);
-            gscaWriteNR22(engine->apu, 0x08);
-            gscaWriteNR23(engine->apu, 0x00);
-            gscaWriteNR24(engine->apu, 0x80);
+            gscaQueueRegisterWrite(engine, GSCA_AR_NR21, 0x00);
+            gscaQueueRegisterWrite(engine, GSCA_AR_NR22, 0x08);
+            gscaQueueRegisterWrite(engine, GSCA_AR_NR23, 0x00);
+            gscaQueueRegisterWrite(engine, GSCA_AR_NR24, 0x80);
             break;
         case GSCA_AC_WAVE:
-            gscaWriteNR30(engine->apu, 0x00);
-            gscaWriteNR31(engine->apu, 0x00);
-            gscaWriteNR32(engine->apu, 0x08);
-            gscaWriteNR33(engine->apu, 0x00);
-            gscaWriteNR34(engine->apu, 0x80);
+            gscaQueueRegisterWrite(engine, GSCA_AR_NR30, 0x00);
+            gscaQueueRegisterWrite(engine, GSCA_AR_NR31, 0x00);
+            gscaQueueRegisterWrite(engine, GSCA_AR_NR32, 0x08);
+            gscaQueueRegisterWrite(engine, GSCA_AR_NR33, 0x00);
+            gscaQueueRegisterWrite(engine, GSCA_AR_NR34, 0x80);
             break;
         case GSCA_AC_NOISE:
-            gscaWriteNR41(engine->apu, 0x00);
-            gscaWriteNR42(engine->apu, 0x08);
-            gscaWriteNR43(engine->apu, 0x00);
-            gscaWriteNR44(engine->apu, 0x80);
+            gscaQueueRegisterWrite(engine, GSCA_AR_NR41, 0x00);
+            gscaQueueRegisterWrite(engine, GSCA_AR_NR42, 0x08);
+            gscaQueueRegisterWrite(engine, GSCA_AR_NR43, 0x00);
+            gscaQueueRegisterWrite(engine, GSCA_AR_NR44, 0x80);
+            break;
+    }
+}
+
+void gscaQueueRegisterWrite (gscaAudioEngine* engine, uint8_t address, uint8_t value)
+{
+    if (engine->writeCount == GSCA_AE_WRITE_LIST_SIZE)
+    {
+        gscaSubmitRegisterWrites(engine);
+    }
+
+    engine->writeList[engine->writeCount++] = (gscaRegisterWrite) { address, value };
+}
+
+uint8_t gscaPeekNR52 (const gscaAudioEngine* engine)
+{
+    // Only `NR52`'s power bit can be written, so a queued write to it is all
+    // that is needed to know what the register will read once it is applied.
+    for (size_t i = engine->writeCount; i > 0; --i)
+    {
+        if (engine->writeList[i - 1].address == GSCA_AR_NR52)
+        {
+            return engine->writeList[i - 1].value & 0b10000000;
+        }
+    }
+
+    if (engine->seeking == true)
+    {
+        return (engine->shadowRegisters[GSCA_AR_NR52] & 0b10000000) | engine->shadowActive;
+    }
+
+    return gscaReadNR52(engine->apu);
+}
+
+void gscaSubmitRegisterWrites (gscaAudioEngine* engine)
+{
+    if (engine->seeking == true)
+    {
+        for (size_t i = 0; i < engine->writeCount; ++i)
+        {
+            gscaShadowRegisterWrite(engine, engine->writeList[i].address,
+                engine->writeList[i].value);
+        }
+    }
+    else
+    {
+        gscaWriteRegisters(engine->apu, engine->writeList, engine->writeCount);
+    }
+
+    engine->writeCount = 0;
+}
+
+uint64_t gscaRunDueUpdate (gscaAudioEngine* engine)
+{
+    uint64_t now = gscaGetAPUCycles(engine->apu);
+
+    // If the APU has been reset, or run on past the next update by the host,
+    // then the update schedule starts over from its current cycle.
+    if (engine->nextUpdateCycle > now + GSCA_UPDATE_INTERVAL ||
+        now >= engine->nextUpdateCycle + GSCA_UPDATE_INTERVAL)
+    {
+        engine->nextUpdateCycle = now;
+    }
+
+    if (now >= engine->nextUpdateCycle)
+    {
+        gscaUpdateAudioEngine(engine);
+        engine->nextUpdateCycle += GSCA_UPDATE_INTERVAL;
+    }
+
+    return engine->nextUpdateCycle;
+}
+
+void gscaShadowRegisterWrite (gscaAudioEngine* engine, uint8_t address, uint8_t value)
+{
+    engine->shadowRegisters[address] = value;
+    engine->shadowWritten |= (1ull << address);
+
+    // Keep track of which channels would be playing: a trigger starts a channel
+    // if its DAC is on, and turning the DAC or the APU off stops it.
+    switch (address)
+    {
+        case GSCA_AR_NR12:
+            if ((value & 0xF8) == 0) { engine->shadowActive &= ~0b0001; }
+            break;
+        case GSCA_AR_NR22:
+            if ((value & 0xF8) == 0) { engine->shadowActive &= ~0b0010; }
+            break;
+        case GSCA_AR_NR30:
+            if ((value & 0x80) == 0) { engine->shadowActive &= ~0b0100; }
+            break;
+        case GSCA_AR_NR42:
+            if ((value & 0xF8) == 0) { engine->shadowActive &= ~0b1000; }
+            break;
+        case GSCA_AR_NR14:
+            if ((value & 0x80) != 0 && (engine->shadowRegisters[GSCA_AR_NR12] & 0xF8) != 0)
+                { engine->shadowActive |= 0b0001; }
+            break;
+        case GSCA_AR_NR24:
+            if ((value & 0x80) != 0 && (engine->shadowRegisters[GSCA_AR_NR22] & 0xF8) != 0)
+                { engine->shadowActive |= 0b0010; }
+            break;
+        case GSCA_AR_NR34:
+            if ((value & 0x80) != 0 && (engine->shadowRegisters[GSCA_AR_NR30] & 0x80) != 0)
+                { engine->shadowActive |= 0b0100; }
+            break;
+        case GSCA_AR_NR44:
+            if ((value & 0x80) != 0 && (engine->shadowRegisters[GSCA_AR_NR42] & 0xF8) != 0)
+                { engine->shadowActive |= 0b1000; }
+            break;
+        case GSCA_AR_NR52:
+            if ((value & 0x80) == 0) { engine->shadowActive = 0; }
+            break;
+        default: break;
+    }
+}
+
+void gscaApplyShadowRegisters (gscaAudioEngine* engine)
+{
+    static const uint8_t CHANNEL_REGISTERS[] = {
+        GSCA_AR_NR10, GSCA_AR_NR11, GSCA_AR_NR12, GSCA_AR_NR13,
+        GSCA_AR_NR21, GSCA_AR_NR22, GSCA_AR_NR23,
+        GSCA_AR_NR31, GSCA_AR_NR32, GSCA_AR_NR33,
+        GSCA_AR_NR41, GSCA_AR_NR42, GSCA_AR_NR43
+    };
+    static const uint8_t TRIGGER_REGISTERS[] = {
+        GSCA_AR_NR14, GSCA_AR_NR24, GSCA_AR_NR34, GSCA_AR_NR44
+    };
+
+    const uint8_t* shadow = engine->shadowRegisters;
+    const uint64_t written = engine->shadowWritten;
+
+    // Power the APU on or off first, as turning it off ignores everything else.
+    if ((written & (1ull << GSCA_AR_NR52)) != 0)
+    {
+        gscaQueueRegisterWrite(engine, GSCA_AR_NR52, shadow[GSCA_AR_NR52]);
+        if ((shadow[GSCA_AR_NR52] & 0x80) == 0)
+        {
+            gscaSubmitRegisterWrites(engine);
+            return;
+        }
+    }
+
+    if ((written & (1ull << GSCA_AR_NR50)) != 0)
+        { gscaQueueRegisterWrite(engine, GSCA_AR_NR50, shadow[GSCA_AR_NR50]); }
+    if ((written & (1ull << GSCA_AR_NR51)) != 0)
+        { gscaQueueRegisterWrite(engine, GSCA_AR_NR51, shadow[GSCA_AR_NR51]); }
+
+    // Wave RAM can only be written with the wave channel's DAC off.
+    if ((written >> GSCA_AR_WAVE_RAM) != 0)
+    {
+        gscaQueueRegisterWrite(engine, GSCA_AR_NR30, 0x00);
+        for (uint8_t i = 0; i < GSCA_WAVE_RAM_SIZE; ++i)
+        {
+            gscaQueueRegisterWrite(engine, GSCA_AR_WAVE_RAM + i,
+                shadow[GSCA_AR_WAVE_RAM + i]);
+        }
+    }
+    if ((written & (1ull << GSCA_AR_NR30)) != 0 || (written >> GSCA_AR_WAVE_RAM) != 0)
+        { gscaQueueRegisterWrite(engine, GSCA_AR_NR30, shadow[GSCA_AR_NR30]); }
+
+    for (size_t i = 0; i < sizeof(CHANNEL_REGISTERS); ++i)
+    {
+        uint8_t address = CHANNEL_REGISTERS[i];
+        if ((written & (1ull << address)) != 0)
+            { gscaQueueRegisterWrite(engine, address, shadow[address]); }
+    }
+
+    // Finally, retrigger the channels which would still be playing, so that they
+    // start their notes over from the final register state.
+    for (uint8_t i = 0; i < 4; ++i)
+    {
+        uint8_t address = TRIGGER_REGISTERS[i];
+        if ((written & (1ull << address)) != 0)
+        {
+            uint8_t trigger = ((engine->shadowActive >> i) & 1) << 7;
+            gscaQueueRegisterWrite(engine, address, (shadow[address] & 0x7F) | trigger);
+        }
+    }
+
+    gscaSubmitRegisterWrites(engine);
+}
+
+bool gscaPostEngineCommand (gscaAudioEngine* engine, uint8_t type, const char* name,
+    uint8_t length, int16_t pitch, int16_t cryLength)
+{
+    // Resolve the name here, on the posting thread, so that the engine's thread
+    // only ever sees handle IDs.
+    const gscaAudioHandle* handle = NULL;
+    if (type != GSCA_EC_STOP_AUDIO)
+    {
+        if (name[0] == '\0')
+        {
+            gscaErr("Audio handle name cannot be blank.\n");
+            return false;
+        }
+
+        handle = gscaGetHandleByName(engine->store, name);
+        if (handle == NULL)
+        {
+            gscaErr("Audio handle '%s' not found.\n", name);
+            return false;
+        }
+    }
+
+    // Claim the slot at the tail of the queue. Another thread may claim it
+    // first, in which case try again with the new tail.
+    size_t position = atomic_load_explicit(&engine->commandTail, memory_order_relaxed);
+    gscaEngineCommand* command = NULL;
+    while (true)
+    {
+        command = &engine->commands[position % GSCA_AE_COMMAND_QUEUE_SIZE];
+        size_t sequence = atomic_load_explicit(&command->sequence, memory_order_acquire);
+        if (sequence == position)
+        {
+            if (atomic_compare_exchange_weak_explicit(&engine->commandTail, &position,
+                position + 1, memory_order_relaxed, memory_order_relaxed) == true)
+            {
+                break;
+            }
+        }
+        else if ((ptrdiff_t) (sequence - position) < 0)
+        {
+            gscaErr("Audio engine command queue is full.\n");
+            return false;
+        }
+        else
+        {
+            position = atomic_load_explicit(&engine->commandTail, memory_order_relaxed);
+        }
+    }
+
+    // Fill the slot, then publish it to the engine's thread.
+    command->type = type;
+    command->length = length;
+    command->id = (handle != NULL) ? handle->id : 0;
+    command->pitch = pitch;
+    command->cryLength = cryLength;
+    atomic_store_explicit(&command->sequence, position + 1, memory_order_release);
+    return true;
+}
+
+void gscaRunEngineCommands (gscaAudioEngine* engine)
+{
+    // Only the engine's thread takes commands off the queue, so the head needs
+    // no atomic operations of its own.
+    while (true)
+    {
+        size_t position = engine->commandHead;
+        gscaEngineCommand* command = &engine->commands[position % GSCA_AE_COMMAND_QUEUE_SIZE];
+        if (atomic_load_explicit(&command->sequence, memory_order_acquire) != position + 1)
+        {
             break;
+        }
+
+        switch (command->type)
+        {
+            case GSCA_EC_STOP_AUDIO:
+                gscaInitAudioEngine(engine);
+                break;
+            case GSCA_EC_FADE_TO_MUSIC:
+                gscaFadeToLoadedMusic(engine, command->id, command->length);
+                break;
+            case GSCA_EC_PLAY_MUSIC:
+                gscaPlayLoadedMusic(engine, command->id);
+                break;
+            case GSCA_EC_PLAY_SFX:
+                gscaPlayLoadedSFX(engine, command->id);
+                break;
+            case GSCA_EC_PLAY_STEREO_SFX:
+                gscaPlayStereoLoadedSFX(engine, command->id);
+                break;
+            case GSCA_EC_PLAY_CRY:
+                ctx.cryPitch = (uint16_t) command->pitch;
+                ctx.cryLength = (uint16_t) command->cryLength;
+                gscaPlayLoadedCry(engine, command->id);
+                break;
+            default: break;
+        }
+
+        // Hand the slot back to the producers, for use on the next lap around
+        // the queue.
+        atomic_store_explicit(&command->sequence, position + GSCA_AE_COMMAND_QUEUE_SIZE,
+            memory_order_release);
+        engine->commandHead = position + 1;
     }
 }
 
@@ -2021,8 +2388,15 @@ gscaAudioEngine* gscaCreateAudioEngine (gscaAPU* apu, gscaAudioStore* audioStore
     
     engine->apu = apu;
     engine->store = audioStore;
+    engine->nextUpdateCycle = gscaGetAPUCycles(apu);
     gscaInitAudioEngine(engine);
 
+    for (size_t i = 0; i < GSCA_AE_COMMAND_QUEUE_SIZE; ++i)
+    {
+        atomic_init(&engine->commands[i].sequence, i);
+    }
+    atomic_init(&engine->commandTail, 0);
+
     return engine;
 }
 
@@ -2032,6 +2406,7 @@ void gscaDestroyAudioEngine (gscaAudioEngine* engine)
     {
         engine->apu = NULL;
         engine->store = NULL;
+        gscaDestroy(engine->program);
         gscaDestroy(engine);
     }
 }
@@ -2048,18 +2423,27 @@ void gscaInitAudioEngine (gscaAudioEngine* engine)
     ctx.noiseSampleAddress  = NULL;
 
     gscaMusicOn(engine);
+    gscaSubmitRegisterWrites(engine);
 }
 
 void gscaUpdateAudioEngine (gscaAudioEngine* engine)
 {
     gscaExpect(engine, "Pointer 'engine' is NULL!\n");
 
+    // Run any commands queued from other threads since the last update. They
+    // may turn the engine on or off.
+    gscaRunEngineCommands(engine);
+
     // Don't bother if the engine is turned off.
     if (engine->musicPlaying == false)
     {
         return;
     }
 
+    // Decode any audio data which has been added to the store since the last
+    // update.
+    gscaDecodeMusicData(engine);
+
     // Reset the sound output from the last update.
     ctx.soundOutput.value = 0x00;
 
@@ -2133,8 +2517,54 @@ void gscaUpdateAudioEngine (gscaAudioEngine* engine)
     gscaFadeMusic(engine);          // Fade music, if needed.
 
     // Write the engine's volume and panning configs to the APU.
-    gscaWriteNR50(engine->apu, ctx.volume.value);
-    gscaWriteNR51(engine->apu, ctx.soundOutput.value);
+    gscaQueueRegisterWrite(engine, GSCA_AR_NR50, ctx.volume.value);
+    gscaQueueRegisterWrite(engine, GSCA_AR_NR51, ctx.soundOutput.value);
+
+    // Submit the frame's register writes to the APU all at once.
+    gscaSubmitRegisterWrites(engine);
+}
+
+size_t gscaRenderEngine (gscaAudioEngine* engine, gscaAudioSample* out, size_t frameCount)
+{
+    gscaExpect(engine, "Pointer 'engine' is NULL!\n");
+    gscaExpect(out != NULL || frameCount == 0, "Pointer 'out' is NULL!\n");
+
+    // Run each engine update on the exact cycle it falls due, then run the APU
+    // up to the cycle of the next one.
+    size_t frames = 0;
+    while (frames < frameCount)
+    {
+        uint64_t cycle = gscaRunDueUpdate(engine);
+        frames += gscaRenderAPUUntil(engine->apu, out + frames, frameCount - frames, cycle);
+    }
+
+    return frames;
+}
+
+size_t gscaRenderEngineFormat (gscaAudioEngine* engine, const gscaOutputFormat* format,
+    void* const* out, size_t frameCount)
+{
+    gscaExpect(engine, "Pointer 'engine' is NULL!\n");
+    gscaExpect(format, "Pointer 'format' is NULL!\n");
+    gscaExpect(out != NULL || frameCount == 0, "Pointer 'out' is NULL!\n");
+
+    size_t frameSize = gscaGetOutputFrameSize(format);
+    size_t buffers = (format->layout == GSCA_SL_PLANAR) ? 2 : 1;
+    size_t frames = 0;
+
+    while (frames < frameCount)
+    {
+        uint64_t cycle = gscaRunDueUpdate(engine);
+
+        void* at[2] = { NULL, NULL };
+        for (size_t i = 0; i < buffers; ++i)
+            { at[i] = (uint8_t*) out[i] + frames * frameSize; }
+
+        frames += gscaRenderAPUFormatUntil(engine->apu, format, at, frameCount - frames,
+            cycle);
+    }
+
+    return frames;
 }
 
 int32_t gscaIsPlayingSFX (const gscaAudioEngine* engine)
@@ -2169,6 +2599,7 @@ bool gscaFadeToMusic (gscaAudioEngine* engine, const char* name, uint8_t length)
     }
 
     gscaFadeToLoadedMusic(engine, handle->id, length);
+    gscaSubmitRegisterWrites(engine);
     return true;
 }
 
@@ -2191,6 +2622,7 @@ bool gscaPlayMusic (gscaAudioEngine* engine, const char* name)
     }
 
     gscaPlayLoadedMusic(engine, handle->id);
+    gscaSubmitRegisterWrites(engine);
     return true;
 }
 
@@ -2213,6 +2645,7 @@ bool gscaPlaySFX (gscaAudioEngine* engine, const char* name)
     }
 
     gscaPlayLoadedSFX(engine, handle->id);
+    gscaSubmitRegisterWrites(engine);
     return true;
 }
 
@@ -2235,6 +2668,7 @@ bool gscaPlayStereoSFX (gscaAudioEngine* engine, const char* name)
     }
 
     gscaPlayStereoLoadedSFX(engine, handle->id);
+    gscaSubmitRegisterWrites(engine);
     return true;    
 }
 
@@ -2260,7 +2694,91 @@ bool gscaPlayCry (gscaAudioEngine* engine, const char* name, int16_t pitch, int1
     ctx.cryLength = (uint16_t) length;
 
     gscaPlayLoadedCry(engine, handle->id);
+    gscaSubmitRegisterWrites(engine);
     return true;
 }
 
+bool gscaQueueStopAudio (gscaAudioEngine* engine)
+{
+    gscaExpect(engine, "Pointer 'engine' is NULL!\n");
+    return gscaPostEngineCommand(engine, GSCA_EC_STOP_AUDIO, NULL, 0, 0, 0);
+}
+
+bool gscaQueueFadeToMusic (gscaAudioEngine* engine, const char* name, uint8_t length)
+{
+    gscaExpect(engine, "Pointer 'engine' is NULL!\n");
+    gscaExpect(name, "Pointer 'name' is NULL!\n");
+    return gscaPostEngineCommand(engine, GSCA_EC_FADE_TO_MUSIC, name, length, 0, 0);
+}
+
+bool gscaQueuePlayMusic (gscaAudioEngine* engine, const char* name)
+{
+    gscaExpect(engine, "Pointer 'engine' is NULL!\n");
+    gscaExpect(name, "Pointer 'name' is NULL!\n");
+    return gscaPostEngineCommand(engine, GSCA_EC_PLAY_MUSIC, name, 0, 0, 0);
+}
+
+bool gscaQueuePlaySFX (gscaAudioEngine* engine, const char* name)
+{
+    gscaExpect(engine, "Pointer 'engine' is NULL!\n");
+    gscaExpect(name, "Pointer 'name' is NULL!\n");
+    return gscaPostEngineCommand(engine, GSCA_EC_PLAY_SFX, name, 0, 0, 0);
+}
+
+bool gscaQueuePlayStereoSFX (gscaAudioEngine* engine, const char* name)
+{
+    gscaExpect(engine, "Pointer 'engine' is NULL!\n");
+    gscaExpect(name, "Pointer 'name' is NULL!\n");
+    return gscaPostEngineCommand(engine, GSCA_EC_PLAY_STEREO_SFX, name, 0, 0, 0);
+}
+
+bool gscaQueuePlayCry (gscaAudioEngine* engine, const char* name, int16_t pitch,
+    int16_t length)
+{
+    gscaExpect(engine, "Pointer 'engine' is NULL!\n");
+    gscaExpect(name, "Pointer 'name' is NULL!\n");
+    return gscaPostEngineCommand(engine, GSCA_EC_PLAY_CRY, name, 0, pitch, length);
+}
+
+void gscaSeekEngine (gscaAudioEngine* engine, size_t frameCount)
+{
+    gscaExpect(engine, "Pointer 'engine' is NULL!\n");
+
+    // Start the shadow register file from the APU's current power and DAC
+    // state, which decide whether a channel triggered during the seek plays.
+    engine->seeking = true;
+    engine->shadowWritten = 0;
+    engine->shadowActive = gscaReadNR52(engine->apu) & 0b1111;
+    engine->shadowRegisters[GSCA_AR_NR52] = gscaReadNR52(engine->apu);
+    engine->shadowRegisters[GSCA_AR_NR12] = gscaReadNR12(engine->apu);
+    engine->shadowRegisters[GSCA_AR_NR22] = gscaReadNR22(engine->apu);
+    engine->shadowRegisters[GSCA_AR_NR30] = gscaReadNR30(engine->apu);
+    engine->shadowRegisters[GSCA_AR_NR42] = gscaReadNR42(engine->apu);
+
+    // Run the engine's updates alone, without the APU.
+    for (size_t i = 0; i < frameCount; ++i)
+    {
+        gscaUpdateAudioEngine(engine);
+    }
+
+    engine->seeking = false;
+    gscaApplyShadowRegisters(engine);
+}
+
+#if defined(GSCA_PROFILE)
+
+const gscaCommandProfile* gscaGetCommandProfile (const gscaAudioEngine* engine, uint8_t opcode)
+{
+    gscaExpect(engine, "Pointer 'engine' is NULL!\n");
+    return &engine->profile[opcode];
+}
+
+void gscaResetCommandProfile (gscaAudioEngine* engine)
+{
+    gscaExpect(engine, "Pointer 'engine' is NULL!\n");
+    gscaZero(engine->profile, 256, gscaCommandProfile);
+}
+
+#endif
+
 #undef ctx
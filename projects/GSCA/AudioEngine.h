@@ -3,11 +3,10 @@
  */
 
 #pragma once
-#include <GSCA/Common.h>
+#include <GSCA/APU.h>
 
 /* Typedefs and Forward Declarations ******************************************/
 
-typedef struct gscaAPU              gscaAPU;
 typedef struct gscaAudioStore       gscaAudioStore;
 typedef struct gscaAudioHandle      gscaAudioHandle;
 typedef struct gscaAudioEngine      gscaAudioEngine;
@@ -81,15 +80,40 @@ typedef union
     uint8_t value;
 } gscaMusicFade;
 
+/* Structures *****************************************************************/
+
+#if defined(GSCA_PROFILE)
+typedef struct
+{
+    uint64_t count;
+    uint64_t nanoseconds;
+} gscaCommandProfile;
+#endif
+
 /* Public Functions ***********************************************************/
 
 GSCA_API gscaAudioEngine* gscaCreateAudioEngine (gscaAPU* apu, gscaAudioStore*);
 GSCA_API void gscaDestroyAudioEngine (gscaAudioEngine* engine);
 GSCA_API void gscaInitAudioEngine (gscaAudioEngine* engine);
 GSCA_API void gscaUpdateAudioEngine (gscaAudioEngine* engine);
+GSCA_API void gscaSeekEngine (gscaAudioEngine* engine, size_t frameCount);
+GSCA_API size_t gscaRenderEngine (gscaAudioEngine* engine, gscaAudioSample* out, size_t frameCount);
+GSCA_API size_t gscaRenderEngineFormat (gscaAudioEngine* engine, const gscaOutputFormat* format,
+    void* const* out, size_t frameCount);
 GSCA_API int32_t gscaIsPlayingSFX (const gscaAudioEngine* engine);
 GSCA_API bool gscaFadeToMusic (gscaAudioEngine* engine, const char* name, uint8_t length);
 GSCA_API bool gscaPlayMusic (gscaAudioEngine* engine, const char* name);
 GSCA_API bool gscaPlaySFX (gscaAudioEngine* engine, const char* name);
 GSCA_API bool gscaPlayStereoSFX (gscaAudioEngine* engine, const char* name);
-GSCA_API bool gscaPlayCry (gscaAudioEngine* engine, const char* name, int16_t pitch, int16_t length);
\ No newline at end of file
+GSCA_API bool gscaPlayCry (gscaAudioEngine* engine, const char* name, int16_t pitch, int16_t length);
+GSCA_API bool gscaQueueStopAudio (gscaAudioEngine* engine);
+GSCA_API bool gscaQueueFadeToMusic (gscaAudioEngine* engine, const char* name, uint8_t length);
+GSCA_API bool gscaQueuePlayMusic (gscaAudioEngine* engine, const char* name);
+GSCA_API bool gscaQueuePlaySFX (gscaAudioEngine* engine, const char* name);
+GSCA_API bool gscaQueuePlayStereoSFX (gscaAudioEngine* engine, const char* name);
+GSCA_API bool gscaQueuePlayCry (gscaAudioEngine* engine, const char* name, int16_t pitch, int16_t length);
+
+#if defined(GSCA_PROFILE)
+GSCA_API const gscaCommandProfile* gscaGetCommandProfile (const gscaAudioEngine* engine, uint8_t opcode);
+GSCA_API void gscaResetCommandProfile (gscaAudioEngine* engine);
+#endif
\ No newline at end of file
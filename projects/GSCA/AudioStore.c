@@ -2,12 +2,22 @@
  * @file    GSCA/AudioStore.c
  */
 
+#include <GSCA/Commands.h>
 #include <GSCA/AudioStore.h>
 
 /* Private Constants **********************************************************/
 
 #define GSCA_AS_HANDLES_INIT_CAPACITY   8
 #define GSCA_AS_MAGIC_NUMBER            0x41435347
+#define GSCA_AS_CHANNEL_HEADER_SIZE     9
+#define GSCA_AS_VERIFIER_INIT_CAPACITY  256
+
+#define GSCA_VS_SFX                     0x01
+#define GSCA_VS_CRY                     0x02
+#define GSCA_VS_NOISE                   0x04
+#define GSCA_VS_SUBROUTINE              0x08
+#define GSCA_VS_NOISE_CHANNEL           0x10
+#define GSCA_VS_LOOPING                 0x20
 
 /* Static Members *************************************************************/
 
@@ -34,8 +44,36 @@ typedef struct gscaAudioStore
     uint8_t*            data;
     size_t              dataSize;
     size_t              dataCapacity;
+
+    bool                verify;
 } gscaAudioStore;
 
+/* Bytecode Verifier Structures ***********************************************/
+
+typedef struct
+{
+    uint64_t    address;
+    uint64_t    returnAddress;
+    uint32_t    walk;
+    uint8_t     flags;
+    uint8_t     transposition;
+} gscaVerifierState;
+
+typedef struct
+{
+    gscaVerifierState*  pending;
+    size_t              pendingSize;
+    size_t              pendingCapacity;
+
+    gscaVerifierState*  visited;
+    size_t              visitedSize;
+    size_t              visitedCapacity;
+
+    uint32_t            walk;
+    const char*         error;
+    uint64_t            errorAddress;
+} gscaVerifier;
+
 /* Private Function Prototypes ************************************************/
 
 static void gscaInitContainers (gscaAudioStore*, size_t);
@@ -56,6 +94,12 @@ static bool gscaWriteWord (FILE*, const uint16_t);
 static bool gscaWriteDoubleWord (FILE*, const uint32_t);
 static bool gscaWriteQuadWord (FILE*, const uint64_t);
 static bool gscaWriteString (FILE*, const char*, size_t);
+static size_t gscaHashVerifierState (uint64_t, uint64_t, uint8_t, uint8_t);
+static bool gscaVisitVerifierState (gscaVerifier*, uint64_t, uint64_t, uint8_t, uint8_t);
+static bool gscaFailVerification (gscaVerifier*, const char*, uint64_t);
+static bool gscaVerifyChannel (const gscaAudioStore*, gscaVerifier*, uint64_t, uint8_t);
+static bool gscaVerifyAudioEntry (const gscaAudioStore*, gscaVerifier*, gscaAudioHandle*);
+static bool gscaVerifyAudioEntries (gscaAudioStore*, size_t);
 
 /* Private Functions **********************************************************/
 
@@ -378,6 +422,402 @@ bool gscaWriteString (FILE* fp, const char* string, size_t length)
     return true;
 }
 
+size_t gscaHashVerifierState (uint64_t address, uint64_t returnAddress, uint8_t flags,
+    uint8_t transposition)
+{
+    uint64_t hash = (address * 0x9E3779B97F4A7C15ull) ^
+        (returnAddress * 0xC2B2AE3D27D4EB4Full) ^ flags ^ ((uint64_t) transposition << 8);
+    return (size_t) (hash ^ (hash >> 29));
+}
+
+bool gscaVisitVerifierState (gscaVerifier* verifier, uint64_t address,
+    uint64_t returnAddress, uint8_t flags, uint8_t transposition)
+{
+    // A channel's return address only matters while it is in a subroutine.
+    if ((flags & GSCA_VS_SUBROUTINE) == 0)
+    {
+        returnAddress = 0;
+    }
+
+    // The visited set is an open-addressed hash table, in which only the slots
+    // stamped with the current walk are in use. Grow it before it gets half
+    // full, carrying over this walk's states.
+    if ((verifier->visitedSize + 1) * 2 > verifier->visitedCapacity)
+    {
+        size_t capacity = verifier->visitedCapacity * 2;
+        gscaVerifierState* visited = gscaCreateZero(capacity, gscaVerifierState);
+        gscaExpectp(visited, "Could not resize bytecode verifier state set");
+
+        for (size_t i = 0; i < verifier->visitedCapacity; ++i)
+        {
+            const gscaVerifierState* state = &verifier->visited[i];
+            if (state->walk == verifier->walk)
+            {
+                size_t slot = gscaHashVerifierState(state->address, state->returnAddress,
+                    state->flags, state->transposition) & (capacity - 1);
+                while (visited[slot].walk == verifier->walk)
+                {
+                    slot = (slot + 1) & (capacity - 1);
+                }
+
+                visited[slot] = *state;
+            }
+        }
+
+        gscaDestroy(verifier->visited);
+        verifier->visited = visited;
+        verifier->visitedCapacity = capacity;
+    }
+
+    size_t mask = verifier->visitedCapacity - 1;
+    size_t slot = gscaHashVerifierState(address, returnAddress, flags, transposition) & mask;
+    while (verifier->visited[slot].walk == verifier->walk)
+    {
+        const gscaVerifierState* state = &verifier->visited[slot];
+        if (
+            state->address == address &&
+            state->returnAddress == returnAddress &&
+            state->flags == flags &&
+            state->transposition == transposition
+        )
+        {
+            return false;
+        }
+
+        slot = (slot + 1) & mask;
+    }
+
+    gscaVerifierState state = { address, returnAddress, verifier->walk, flags, transposition };
+    verifier->visited[slot] = state;
+    verifier->visitedSize++;
+
+    if (verifier->pendingSize >= verifier->pendingCapacity)
+    {
+        verifier->pendingCapacity *= 2;
+        gscaVerifierState* pending =
+            gscaResize(verifier->pending, verifier->pendingCapacity, gscaVerifierState);
+        gscaExpectp(pending, "Could not resize bytecode verifier work list");
+        verifier->pending = pending;
+    }
+
+    verifier->pending[verifier->pendingSize++] = state;
+    return true;
+}
+
+bool gscaFailVerification (gscaVerifier* verifier, const char* error, uint64_t address)
+{
+    verifier->error = error;
+    verifier->errorAddress = address;
+    return false;
+}
+
+bool gscaVerifyChannel (const gscaAudioStore* audioStore, gscaVerifier* verifier,
+    uint64_t address, uint8_t flags)
+{
+    const uint8_t* data = audioStore->data;
+    const size_t size = audioStore->dataSize;
+
+    // Walk every path the channel can take through the bytecode. How many
+    // operands a note or command takes, and which notes it can play, depends on
+    // the channel's state, so each state is tracked along with the address.
+    verifier->walk++;
+    verifier->visitedSize = 0;
+    verifier->pendingSize = 0;
+    gscaVisitVerifierState(verifier, address, 0, flags, 0);
+
+    while (verifier->pendingSize > 0)
+    {
+        gscaVerifierState state = verifier->pending[--verifier->pendingSize];
+        address = state.address;
+        flags = state.flags;
+        uint8_t transposition = state.transposition;
+
+        if (address >= size)
+        {
+            return gscaFailVerification(verifier, "Channel runs past the end of the data",
+                address);
+        }
+
+        const uint8_t opcode = data[address];
+        const bool noiseChannel = (flags & GSCA_VS_NOISE_CHANNEL) != 0;
+        size_t length = 1;
+
+        if (opcode < GSCA_FIRST_MUSIC_CMD)
+        {
+            // SFX and cry notes carry their volume envelope and frequency with
+            // them.
+            if ((flags & (GSCA_VS_SFX | GSCA_VS_CRY)) != 0)
+            {
+                length = (noiseChannel == true) ? 3 : 4;
+            }
+        }
+        else
+        {
+            switch (opcode)
+            {
+                case GSCA_OCTAVE_CMD0:
+                case GSCA_OCTAVE_CMD1:
+                case GSCA_OCTAVE_CMD2:
+                case GSCA_OCTAVE_CMD3:
+                case GSCA_OCTAVE_CMD4:
+                case GSCA_OCTAVE_CMD5:
+                case GSCA_OCTAVE_CMD6:
+                case GSCA_OCTAVE_CMD7:
+                case GSCA_SFX_PRIORITY_ON_CMD:
+                case GSCA_SFX_PRIORITY_OFF_CMD:
+                case GSCA_SOUND_RET_CMD:
+                    break;
+                case GSCA_TOGGLE_SFX_CMD:
+                    flags ^= GSCA_VS_SFX;
+                    break;
+                case GSCA_NOTE_TYPE_CMD:
+                    length = (noiseChannel == true) ? 2 : 3;
+                    break;
+                case GSCA_TRANSPOSE_CMD:
+                case GSCA_DUTY_CYCLE_CMD:
+                case GSCA_VOLUME_ENVELOPE_CMD:
+                case GSCA_PITCH_SWEEP_CMD:
+                case GSCA_DUTY_CYCLE_PATTERN_CMD:
+                case GSCA_FORCE_STEREO_PANNING_CMD:
+                case GSCA_VOLUME_CMD:
+                case GSCA_TEMPO_RELATIVE_CMD:
+                case GSCA_STEREO_PANNING_CMD:
+                case GSCA_SET_CONDITION_CMD:
+                    length = 2;
+                    break;
+                case GSCA_TEMPO_CMD:
+                case GSCA_PITCH_SLIDE_CMD:
+                case GSCA_VIBRATO_CMD:
+                case GSCA_PITCH_OFFSET_CMD:
+                case GSCA_RESTART_CHANNEL_CMD:
+                case GSCA_NEW_SONG_CMD:
+                    length = 3;
+                    break;
+                case GSCA_TOGGLE_NOISE_CMD:
+                case GSCA_SFX_TOGGLE_NOISE_CMD:
+                    flags ^= GSCA_VS_NOISE;
+                    length = ((flags & GSCA_VS_NOISE) != 0) ? 2 : 1;
+                    break;
+                case GSCA_SOUND_JUMP_CMD:
+                case GSCA_SOUND_CALL_CMD:
+                    length = 9;
+                    break;
+                case GSCA_SOUND_JUMP_IF_CMD:
+                case GSCA_SOUND_LOOP_CMD:
+                    length = 10;
+                    break;
+                default:
+                    return gscaFailVerification(verifier, "Unknown command", address);
+            }
+        }
+
+        if (address + length > size)
+        {
+            return gscaFailVerification(verifier, "Command runs past the end of the data",
+                address);
+        }
+
+        // Check the operands which the engine uses as indices or addresses.
+        // A music note and a pitch slide's target index the engine's
+        // frequency table once the transposition is added to them.
+        if (
+            opcode < GSCA_FIRST_MUSIC_CMD &&
+            (flags & (GSCA_VS_SFX | GSCA_VS_CRY | GSCA_VS_NOISE)) == 0 &&
+            (opcode >> 4) + transposition >= GSCA_FREQUENCY_COUNT
+        )
+        {
+            return gscaFailVerification(verifier, "Note is out of range", address);
+        }
+
+        size_t offset = address + length - 8;
+        uint64_t target = 0;
+        switch (opcode)
+        {
+            case GSCA_TRANSPOSE_CMD:
+                // Only the lower nibble moves the note; the upper nibble moves
+                // the octave, which the engine clamps.
+                transposition = data[address + 1] & 0xF;
+                break;
+            case GSCA_PITCH_SLIDE_CMD:
+                if ((data[address + 2] & 0xF) + transposition >= GSCA_FREQUENCY_COUNT)
+                {
+                    return gscaFailVerification(verifier, "Pitch slide target is out of range",
+                        address);
+                }
+                break;
+            case GSCA_TOGGLE_NOISE_CMD:
+            case GSCA_SFX_TOGGLE_NOISE_CMD:
+                if (length == 2 && data[address + 1] >= GSCA_DRUMKIT_COUNT)
+                {
+                    return gscaFailVerification(verifier, "Noise sample set is out of range",
+                        address);
+                }
+                break;
+            case GSCA_SOUND_JUMP_CMD:
+            case GSCA_SOUND_CALL_CMD:
+            case GSCA_SOUND_JUMP_IF_CMD:
+            case GSCA_SOUND_LOOP_CMD:
+                gscaReadQuadWordFromBuffer(data, size, &offset, &target);
+                if (target >= size)
+                {
+                    return gscaFailVerification(verifier, "Branch target is out of range",
+                        address);
+                }
+                break;
+            default: break;
+        }
+
+        // Queue the states which the command can lead to.
+        uint64_t next = address + length;
+        switch (opcode)
+        {
+            case GSCA_SOUND_JUMP_CMD:
+                gscaVisitVerifierState(verifier, target, state.returnAddress, flags,
+                    transposition);
+                break;
+            case GSCA_SOUND_JUMP_IF_CMD:
+                gscaVisitVerifierState(verifier, target, state.returnAddress, flags,
+                    transposition);
+                gscaVisitVerifierState(verifier, next, state.returnAddress, flags,
+                    transposition);
+                break;
+            case GSCA_SOUND_LOOP_CMD:
+            {
+                // The loop count itself is not tracked, only whether a counted
+                // loop is running. An infinite loop never falls through.
+                uint8_t count = data[address + 1];
+                if ((flags & GSCA_VS_LOOPING) != 0 || count > 1)
+                {
+                    gscaVisitVerifierState(verifier, target, state.returnAddress,
+                        flags | GSCA_VS_LOOPING, transposition);
+                }
+                else if (count == 0)
+                {
+                    gscaVisitVerifierState(verifier, target, state.returnAddress, flags,
+                        transposition);
+                }
+
+                if ((flags & GSCA_VS_LOOPING) != 0 || count == 1)
+                {
+                    gscaVisitVerifierState(verifier, next, state.returnAddress,
+                        flags & ~GSCA_VS_LOOPING, transposition);
+                }
+            } break;
+            case GSCA_SOUND_CALL_CMD:
+                gscaVisitVerifierState(verifier, target, next, flags | GSCA_VS_SUBROUTINE,
+                    transposition);
+                break;
+            case GSCA_SOUND_RET_CMD:
+                // Returning from outside of a subroutine ends the channel.
+                if ((flags & GSCA_VS_SUBROUTINE) != 0)
+                {
+                    gscaVisitVerifierState(verifier, state.returnAddress, 0,
+                        flags & ~GSCA_VS_SUBROUTINE, transposition);
+                }
+                break;
+            default:
+                gscaVisitVerifierState(verifier, next, state.returnAddress, flags,
+                    transposition);
+                break;
+        }
+    }
+
+    return true;
+}
+
+bool gscaVerifyAudioEntry (const gscaAudioStore* audioStore, gscaVerifier* verifier,
+    gscaAudioHandle* handle)
+{
+    // An entry may be played as music, as a sound effect or as a cry, which
+    // read notes differently, so it is verified for each in turn.
+    static const struct { uint8_t verification, flags; } MODES[] = {
+        { GSCA_AV_MUSIC,    0 },
+        { GSCA_AV_SFX,      GSCA_VS_SFX },
+        { GSCA_AV_CRY,      GSCA_VS_CRY }
+    };
+
+    const uint8_t* data = audioStore->data;
+    const size_t size = audioStore->dataSize;
+    handle->verified = 0;
+
+    if (handle->offset >= size)
+    {
+        return gscaFailVerification(verifier, "Header is out of range", handle->offset);
+    }
+
+    size_t channelCount = ((data[handle->offset] >> 6) & 0b11) + 1;
+    if (handle->offset + channelCount * GSCA_AS_CHANNEL_HEADER_SIZE > size)
+    {
+        return gscaFailVerification(verifier, "Header runs past the end of the data",
+            handle->offset);
+    }
+
+    const char* error = NULL;
+    uint64_t errorAddress = 0;
+    for (size_t i = 0; i < sizeof(MODES) / sizeof(MODES[0]); ++i)
+    {
+        bool ok = true;
+        for (size_t j = 0; j < channelCount && ok == true; ++j)
+        {
+            size_t cursor = handle->offset + j * GSCA_AS_CHANNEL_HEADER_SIZE;
+            uint8_t flags = MODES[i].flags;
+            if ((data[cursor++] & 0b11) == 0b11)
+            {
+                flags |= GSCA_VS_NOISE_CHANNEL;
+            }
+
+            uint64_t address = 0;
+            gscaReadQuadWordFromBuffer(data, size, &cursor, &address);
+            ok = (address < size)
+                ? gscaVerifyChannel(audioStore, verifier, address, flags)
+                : gscaFailVerification(verifier, "Channel address is out of range", cursor - 8);
+        }
+
+        if (ok == true)
+        {
+            handle->verified |= MODES[i].verification;
+        }
+        else if (error == NULL)
+        {
+            error = verifier->error;
+            errorAddress = verifier->errorAddress;
+        }
+    }
+
+    if (handle->verified == 0)
+    {
+        return gscaFailVerification(verifier, error, errorAddress);
+    }
+
+    return true;
+}
+
+bool gscaVerifyAudioEntries (gscaAudioStore* audioStore, size_t first)
+{
+    gscaVerifier verifier = { 0 };
+    verifier.pending = gscaCreate(GSCA_AS_VERIFIER_INIT_CAPACITY, gscaVerifierState);
+    verifier.visited = gscaCreateZero(GSCA_AS_VERIFIER_INIT_CAPACITY, gscaVerifierState);
+    gscaExpectp(verifier.pending && verifier.visited, "Could not allocate bytecode verifier");
+    verifier.pendingCapacity = GSCA_AS_VERIFIER_INIT_CAPACITY;
+    verifier.visitedCapacity = GSCA_AS_VERIFIER_INIT_CAPACITY;
+
+    bool ok = true;
+    for (size_t i = first; i < audioStore->handlesSize && ok == true; ++i)
+    {
+        gscaAudioHandle* handle = &audioStore->handles[i];
+        ok = gscaVerifyAudioEntry(audioStore, &verifier, handle);
+        if (ok == false)
+        {
+            gscaErr("Audio entry '%s' failed verification: %s (at $%llX).\n", handle->name,
+                verifier.error, (unsigned long long) verifier.errorAddress);
+        }
+    }
+
+    gscaDestroy(verifier.pending);
+    gscaDestroy(verifier.visited);
+    return ok;
+}
+
 /* Public Functions ***********************************************************/
 
 gscaAudioStore* gscaCreateAudioStore (size_t initialCapacity)
@@ -399,6 +839,12 @@ void gscaDestroyAudioStore (gscaAudioStore* audioStore)
     }
 }
 
+void gscaSetAudioVerification (gscaAudioStore* audioStore, bool verify)
+{
+    gscaExpect(audioStore, "Pointer 'audioStore' is NULL!\n");
+    audioStore->verify = verify;
+}
+
 bool gscaReadAudioBuffer (gscaAudioStore* audioStore, const uint8_t* data, size_t size)
 {
     gscaExpect(audioStore, "Pointer 'audioStore' is NULL!\n");
@@ -445,6 +891,8 @@ bool gscaReadAudioBuffer (gscaAudioStore* audioStore, const uint8_t* data, size_
     }
 
     // Load audio handles.
+    size_t firstHandle = audioStore->handlesSize;
+    size_t firstData = audioStore->dataSize;
     size_t dataSize = size - sizeof(header);
     for (uint16_t i = 0; i < header.audioCount; ++i)
     {
@@ -461,6 +909,7 @@ bool gscaReadAudioBuffer (gscaAudioStore* audioStore, const uint8_t* data, size_
 
         handle->offset += audioStore->dataSize;
         handle->id = gscaNextId++;
+        handle->verified = 0;
         dataSize -= (sizeof(handle->name) + sizeof(handle->offset));
     }
 
@@ -473,6 +922,15 @@ bool gscaReadAudioBuffer (gscaAudioStore* audioStore, const uint8_t* data, size_
     );
 
     audioStore->dataSize += dataSize;
+
+    // Verify the new entries' bytecode, backing them out if any of it is bad.
+    if (audioStore->verify == true && gscaVerifyAudioEntries(audioStore, firstHandle) == false)
+    {
+        audioStore->handlesSize = firstHandle;
+        audioStore->dataSize = firstData;
+        return false;
+    }
+
     return true;
 }
 
@@ -542,6 +1000,8 @@ bool gscaReadAudioFile (gscaAudioStore* audioStore, const char* filename)
     }
 
     // Load audio handles.
+    size_t firstHandle = audioStore->handlesSize;
+    size_t firstData = audioStore->dataSize;
     size_t dataSize = size - sizeof(header);
     for (uint16_t i = 0; i < header.audioCount; ++i)
     {
@@ -558,6 +1018,7 @@ bool gscaReadAudioFile (gscaAudioStore* audioStore, const char* filename)
 
         handle->offset += audioStore->dataSize;
         handle->id = gscaNextId++;
+        handle->verified = 0;
         dataSize -= (sizeof(handle->name) + sizeof(handle->offset));
     }
 
@@ -579,6 +1040,14 @@ bool gscaReadAudioFile (gscaAudioStore* audioStore, const char* filename)
     
     fclose(fp);
     audioStore->dataSize += dataSize;
+
+    // Verify the new entries' bytecode, backing them out if any of it is bad.
+    if (audioStore->verify == true && gscaVerifyAudioEntries(audioStore, firstHandle) == false)
+    {
+        audioStore->handlesSize = firstHandle;
+        audioStore->dataSize = firstData;
+        return false;
+    }
     
     return true;
 }
@@ -722,11 +1191,22 @@ const gscaAudioHandle* gscaAddAudio (gscaAudioStore* audioStore, const char* nam
     gscaCopyString(handle->name, name, GSCA_AS_HANDLE_NAME_STRLEN);
     handle->offset = audioStore->dataSize;
     handle->id = gscaNextId++;
+    handle->verified = 0;
 
     gscaResizeDataBuffer(audioStore, size);
     gscaCopyOffset(audioStore->data, handle->offset, data, 0, size, uint8_t);
     audioStore->dataSize += size;
 
+    if (
+        audioStore->verify == true &&
+        gscaVerifyAudioEntries(audioStore, audioStore->handlesSize - 1) == false
+    )
+    {
+        audioStore->handlesSize--;
+        audioStore->dataSize = handle->offset;
+        return nullptr;
+    }
+
     return handle;
 }
 
@@ -9,6 +9,15 @@
 
 typedef struct gscaAudioStore   gscaAudioStore;
 
+/* Enumerations ***************************************************************/
+
+typedef enum
+{
+    GSCA_AV_MUSIC   = 0b001,
+    GSCA_AV_SFX     = 0b010,
+    GSCA_AV_CRY     = 0b100
+} gscaAudioVerification;
+
 /* Audio Handle Structure *****************************************************/
 
 typedef struct gscaAudioHandle
@@ -16,12 +25,14 @@ typedef struct gscaAudioHandle
     char        name[GSCA_AS_HANDLE_NAME_STRLEN];
     uint64_t    offset;
     uint16_t    id;
+    uint8_t     verified;
 } gscaAudioHandle;
 
 /* Public Function Prototypes *************************************************/
 
 GSCA_API gscaAudioStore* gscaCreateAudioStore (size_t initialCapacity);
 GSCA_API void gscaDestroyAudioStore (gscaAudioStore* audioStore);
+GSCA_API void gscaSetAudioVerification (gscaAudioStore* audioStore, bool verify);
 GSCA_API bool gscaReadAudioBuffer (gscaAudioStore* audioStore, const uint8_t* data, size_t size);
 GSCA_API bool gscaReadAudioFile (gscaAudioStore* audioStore, const char* filename);
 GSCA_API bool gscaWriteAudioFile (const gscaAudioStore* audioStore, const char* filename);
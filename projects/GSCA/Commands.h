@@ -50,6 +50,8 @@
 #define GSCA_SOUND_CALL_CMD             0XFE
 #define GSCA_SOUND_RET_CMD              0XFF
 #define GSCA_FIRST_MUSIC_CMD            GSCA_OCTAVE_CMD
+#define GSCA_DRUMKIT_COUNT              6
+#define GSCA_FREQUENCY_COUNT            25
 
 #define GSCA_SQUARE_NOTE(length, volume, fade, frequency) \
     length, \
@@ -8,21 +8,36 @@
 /* Include Files **************************************************************/
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 #include <assert.h>
 #include <ctype.h>
 #include <errno.h>
 #include <math.h>
 
+#if defined(_WIN32)
+    #include <malloc.h>
+#endif
+
 /* Object/Constant Macros *****************************************************/
 
 #define GSCA_API
 #define GSCA_MAJOR_VERSION              0x01
 #define GSCA_MINOR_VERSION              0x00
 #define GSCA_DEFAULT_SAMPLE_RATE        44100
+#define GSCA_CLOCK_RATE                 4194304
+#define GSCA_AUDIO_CHANNEL_COUNT        4
+#define GSCA_APU_BATCH_LANES            8
+#define GSCA_APU_MAX_OUTPUT_TAPS        4
+#define GSCA_BLIP_PHASES                64
+#define GSCA_BLIP_TAPS                  32
+#define GSCA_BLIP_BUFFER_SIZE           64
+#define GSCA_BLIP_LEVEL_SCALE           65536
+#define GSCA_BLIP_KERNEL_SCALE          32768
 #define GSCA_WAVE_RAM_SIZE              16
 #define GSCA_WAVE_RAM_NIBBLE_SIZE       32
 #define GSCA_UPDATE_INTERVAL            70224
@@ -59,6 +74,21 @@
 #define gscaToggleBit(val, bit)         val = (val ^ (1 << bit))
 #define gscaChangeBit(val, bit, on)     if (on) { gscaSetBit(val, bit); } else { gscaClearBit(val, bit); }
 
+#define gscaAlignedSize(count, type) \
+    ((count * sizeof(type) + _Alignof(type) - 1) / _Alignof(type) * _Alignof(type))
+
+// Windows' C runtime has no `aligned_alloc`, and memory from its replacement
+// must be freed with `_aligned_free`.
+#if defined(_WIN32)
+    #define gscaCreateAligned(count, type) \
+        ((type*) _aligned_malloc(gscaAlignedSize(count, type), _Alignof(type)))
+    #define gscaDestroyAligned(ptr)     if (ptr != NULL) { _aligned_free(ptr); } ptr = NULL;
+#else
+    #define gscaCreateAligned(count, type) \
+        ((type*) aligned_alloc(_Alignof(type), gscaAlignedSize(count, type)))
+    #define gscaDestroyAligned(ptr)     if (ptr != NULL) { free(ptr); } ptr = NULL;
+#endif
+
 #define gscaCopyOffset(to, toOffset, from, fromOffset, count, type) \
     memcpy( \
         to + (toOffset * sizeof(type)), \
@@ -10,6 +10,8 @@ extern "C"
 #endif
 
 #include <GSCA/APU.h>
+#include <GSCA/RegisterLog.h>
+#include <GSCA/RegisterPlayer.h>
 #include <GSCA/AudioStore.h>
 #include <GSCA/AudioEngine.h>
 #include <GSCA/Commands.h>
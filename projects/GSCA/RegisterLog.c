@@ -0,0 +1,350 @@
+/**
+ * @file    GSCA/RegisterLog.c
+ */
+
+#include <GSCA/RegisterLog.h>
+
+/* Private Constants **********************************************************/
+
+#define GSCA_RL_BLOCK_SIZE              4096
+#define GSCA_RL_BLOCKS_INIT_CAPACITY    8
+#define GSCA_RL_MAGIC_NUMBER            0x52435347
+#define GSCA_RL_HEADER_SIZE             10
+#define GSCA_RL_MAX_ENTRY_SIZE          12
+
+/* Register Log File Header Structure *****************************************/
+
+typedef struct
+{
+    uint32_t    magicNumber;    ///< @brief `$0000` - 4 byte magic identifier `GSCR`.
+    uint32_t    entryCount;     ///< @brief `$0006` - Number of register writes expected.
+    uint8_t     majorVersion;   ///< @brief `$0004` - Major version - must be `==` library version.
+    uint8_t     minorVersion;   ///< @brief `$0005` - Minor version - must be `<=` library version.
+} gscaRegisterLogFileHeader;
+
+/* Register Log Structure *****************************************************/
+
+typedef struct gscaRegisterLog
+{
+    gscaRegisterLogEntry**  blocks;
+    size_t                  blocksSize;
+    size_t                  blocksCapacity;
+
+    gscaRegisterLogEntry*   tail;
+    size_t                  tailSize;
+    size_t                  size;
+} gscaRegisterLog;
+
+/* Private Function Prototypes ************************************************/
+
+static void gscaAppendRegisterLogBlock (gscaRegisterLog*);
+static size_t gscaEncodeRegisterLogEntry (uint8_t*, uint64_t, uint8_t, uint8_t);
+static bool gscaDecodeRegisterLogEntry (const uint8_t*, size_t, size_t*, uint64_t*, uint8_t*,
+    uint8_t*);
+
+/* Private Functions **********************************************************/
+
+void gscaAppendRegisterLogBlock (gscaRegisterLog* log)
+{
+    size_t block = log->size / GSCA_RL_BLOCK_SIZE;
+
+    // Blocks kept from before the log was last cleared are reused first.
+    if (block >= log->blocksSize)
+    {
+        if (log->blocksSize >= log->blocksCapacity)
+        {
+            log->blocksCapacity *= 2;
+            gscaRegisterLogEntry** blocks =
+                gscaResize(log->blocks, log->blocksCapacity, gscaRegisterLogEntry*);
+            gscaExpectp(blocks, "Could not resize register log block array");
+            log->blocks = blocks;
+        }
+
+        log->blocks[log->blocksSize] = gscaCreate(GSCA_RL_BLOCK_SIZE, gscaRegisterLogEntry);
+        gscaExpectp(log->blocks[log->blocksSize], "Could not allocate register log block");
+        log->blocksSize++;
+    }
+
+    log->tail = log->blocks[block];
+    log->tailSize = 0;
+}
+
+size_t gscaEncodeRegisterLogEntry (uint8_t* data, uint64_t delta, uint8_t address,
+    uint8_t value)
+{
+    size_t size = 0;
+
+    // The cycle delta is stored seven bits at a time, low bits first, with the
+    // high bit of each byte set if another byte follows.
+    do
+    {
+        data[size++] = (delta & 0x7F) | ((delta > 0x7F) ? 0x80 : 0x00);
+        delta >>= 7;
+    } while (delta > 0);
+
+    data[size++] = address;
+    data[size++] = value;
+    return size;
+}
+
+bool gscaDecodeRegisterLogEntry (const uint8_t* data, size_t size, size_t* offset,
+    uint64_t* delta, uint8_t* address, uint8_t* value)
+{
+    uint8_t byte = 0x80;
+    *delta = 0;
+
+    for (size_t shift = 0; (byte & 0x80) != 0; shift += 7)
+    {
+        if (*offset >= size || shift >= 64)
+        {
+            return false;
+        }
+
+        byte = data[(*offset)++];
+        *delta |= (uint64_t) (byte & 0x7F) << shift;
+    }
+
+    if (*offset + 2 > size)
+    {
+        return false;
+    }
+
+    *address = data[(*offset)++];
+    *value = data[(*offset)++];
+    return true;
+}
+
+/* Public Functions ***********************************************************/
+
+gscaRegisterLog* gscaCreateRegisterLog ()
+{
+    gscaRegisterLog* log = gscaCreateZero(1, gscaRegisterLog);
+    gscaExpectp(log, "Could not allocate register log");
+
+    log->blocks = gscaCreate(GSCA_RL_BLOCKS_INIT_CAPACITY, gscaRegisterLogEntry*);
+    gscaExpectp(log->blocks, "Could not allocate register log block array");
+    log->blocksCapacity = GSCA_RL_BLOCKS_INIT_CAPACITY;
+
+    // Start with a full, empty tail, so that the first append allocates a block.
+    log->tailSize = GSCA_RL_BLOCK_SIZE;
+
+    return log;
+}
+
+void gscaDestroyRegisterLog (gscaRegisterLog* log)
+{
+    if (log != NULL)
+    {
+        for (size_t i = 0; i < log->blocksSize; ++i)
+        {
+            gscaDestroy(log->blocks[i]);
+        }
+
+        gscaDestroy(log->blocks);
+        gscaDestroy(log);
+    }
+}
+
+void gscaClearRegisterLog (gscaRegisterLog* log)
+{
+    gscaExpect(log, "Pointer 'log' is NULL!\n");
+
+    log->tail = NULL;
+    log->tailSize = GSCA_RL_BLOCK_SIZE;
+    log->size = 0;
+}
+
+void gscaAppendRegisterLog (gscaRegisterLog* log, uint64_t cycle, uint8_t address,
+    uint8_t value)
+{
+    gscaExpect(log, "Pointer 'log' is NULL!\n");
+
+    if (log->tailSize == GSCA_RL_BLOCK_SIZE)
+    {
+        gscaAppendRegisterLogBlock(log);
+    }
+
+    gscaRegisterLogEntry* entry = &log->tail[log->tailSize++];
+    entry->cycle = cycle;
+    entry->address = address;
+    entry->value = value;
+    log->size++;
+}
+
+size_t gscaGetRegisterLogSize (const gscaRegisterLog* log)
+{
+    gscaExpect(log, "Pointer 'log' is NULL!\n");
+    return log->size;
+}
+
+const gscaRegisterLogEntry* gscaGetRegisterLogEntry (const gscaRegisterLog* log,
+    size_t index)
+{
+    gscaExpect(log, "Pointer 'log' is NULL!\n");
+    gscaCheckv(index < log->size, NULL, "Register log index %zu is out of range.\n", index);
+
+    return &log->blocks[index / GSCA_RL_BLOCK_SIZE][index % GSCA_RL_BLOCK_SIZE];
+}
+
+bool gscaReadRegisterLogFile (gscaRegisterLog* log, const char* filename)
+{
+    gscaExpect(log, "Pointer 'log' is NULL!\n");
+    gscaExpect(filename, "Pointer 'filename' is NULL!\n");
+
+    if (filename[0] == '\0')
+    {
+        gscaErr("Filename string cannot be blank.\n");
+        return false;
+    }
+
+    FILE* fp = fopen(filename, "rb");
+    if (fp == NULL)
+    {
+        gscaErrp("Cannot open file '%s' for reading", filename);
+        return false;
+    }
+
+    // Get and validate file size.
+    fseek(fp, 0, SEEK_END);
+    long size = ftell(fp);
+    if (size < 0)
+    {
+        gscaErrp("Cannot get size of file '%s'", filename);
+        fclose(fp); return false;
+    }
+    else if (size < GSCA_RL_HEADER_SIZE)
+    {
+        gscaErr("File '%s' is too small.\n", filename);
+        fclose(fp); return false;
+    }
+    rewind(fp);
+
+    // Read the whole file, then decode it from memory.
+    uint8_t* data = gscaCreate(size, uint8_t);
+    gscaExpectp(data, "Could not allocate register log file buffer");
+    if (fread(data, sizeof(uint8_t), size, fp) != (size_t) size)
+    {
+        gscaErrp("Read error occured while reading file '%s'", filename);
+        gscaDestroy(data);
+        fclose(fp); return false;
+    }
+    fclose(fp);
+
+    // Read and validate header.
+    gscaRegisterLogFileHeader header;
+    header.magicNumber =
+        (data[0] << 0) | (data[1] << 8) | (data[2] << 16) | ((uint32_t) data[3] << 24);
+    header.majorVersion = data[4];
+    header.minorVersion = data[5];
+    header.entryCount =
+        (data[6] << 0) | (data[7] << 8) | (data[8] << 16) | ((uint32_t) data[9] << 24);
+
+    if (header.magicNumber != GSCA_RL_MAGIC_NUMBER)
+    {
+        gscaErr("File '%s' has incorrect magic number (0x%08X).\n", filename,
+            header.magicNumber);
+        gscaDestroy(data); return false;
+    }
+    else if (header.majorVersion != GSCA_MAJOR_VERSION)
+    {
+        gscaErr("File '%s' has incorrect major version.\n", filename);
+        gscaDestroy(data); return false;
+    }
+    else if (header.minorVersion > GSCA_MINOR_VERSION)
+    {
+        gscaErr("File '%s' has incorrect minor version.\n", filename);
+        gscaDestroy(data); return false;
+    }
+
+    // Check that every entry decodes before any is appended, so that a
+    // truncated or corrupt file leaves the log as it was.
+    size_t offset = GSCA_RL_HEADER_SIZE;
+    uint64_t delta = 0;
+    uint8_t address = 0, value = 0;
+    for (uint32_t i = 0; i < header.entryCount; ++i)
+    {
+        if (gscaDecodeRegisterLogEntry(data, size, &offset, &delta, &address, &value) == false)
+        {
+            gscaErr("Could not read register write #%u from file '%s'.\n", i, filename);
+            gscaDestroy(data); return false;
+        }
+    }
+
+    // Decode entries again, restoring each one's cycle from the running total
+    // of the stored deltas. The file's first cycle follows on from the log's
+    // last entry, so that the log's cycles never go backwards.
+    offset = GSCA_RL_HEADER_SIZE;
+    uint64_t cycle = (log->size > 0) ? log->tail[log->tailSize - 1].cycle : 0;
+    for (uint32_t i = 0; i < header.entryCount; ++i)
+    {
+        gscaDecodeRegisterLogEntry(data, size, &offset, &delta, &address, &value);
+        cycle += delta;
+        gscaAppendRegisterLog(log, cycle, address, value);
+    }
+
+    gscaDestroy(data);
+    return true;
+}
+
+bool gscaWriteRegisterLogFile (const gscaRegisterLog* log, const char* filename)
+{
+    gscaExpect(log, "Pointer 'log' is NULL!\n");
+    gscaExpect(filename, "Pointer 'filename' is NULL!\n");
+
+    if (filename[0] == '\0')
+    {
+        gscaErr("Filename string cannot be blank.\n");
+        return false;
+    }
+    else if (log->size > UINT32_MAX)
+    {
+        gscaErr("Register log has too many entries (%zu) to write.\n", log->size);
+        return false;
+    }
+
+    // Encode the header and entries into memory, then write them out at once.
+    uint8_t* data = gscaCreate(GSCA_RL_HEADER_SIZE + log->size * GSCA_RL_MAX_ENTRY_SIZE,
+        uint8_t);
+    gscaExpectp(data, "Could not allocate register log file buffer");
+
+    uint32_t header[2] = { GSCA_RL_MAGIC_NUMBER, (uint32_t) log->size };
+    for (size_t i = 0; i < 4; ++i)
+    {
+        data[i] = (header[0] >> (i * 8)) & 0xFF;
+        data[6 + i] = (header[1] >> (i * 8)) & 0xFF;
+    }
+    data[4] = GSCA_MAJOR_VERSION;
+    data[5] = GSCA_MINOR_VERSION;
+
+    size_t size = GSCA_RL_HEADER_SIZE;
+    uint64_t cycle = 0;
+    for (size_t i = 0; i < log->size; ++i)
+    {
+        const gscaRegisterLogEntry* entry =
+            &log->blocks[i / GSCA_RL_BLOCK_SIZE][i % GSCA_RL_BLOCK_SIZE];
+        uint64_t delta = (entry->cycle > cycle) ? (entry->cycle - cycle) : 0;
+        size += gscaEncodeRegisterLogEntry(data + size, delta, entry->address, entry->value);
+        cycle += delta;
+    }
+
+    FILE* fp = fopen(filename, "wb");
+    if (fp == NULL)
+    {
+        gscaErrp("Cannot open file '%s' for writing", filename);
+        gscaDestroy(data);
+        return false;
+    }
+
+    fwrite(data, sizeof(uint8_t), size, fp);
+    if (ferror(fp))
+    {
+        gscaErrp("Could not write register log to file '%s'", filename);
+        gscaDestroy(data);
+        fclose(fp);
+        return false;
+    }
+
+    gscaDestroy(data);
+    fclose(fp);
+    return true;
+}
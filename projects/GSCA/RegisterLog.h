@@ -0,0 +1,111 @@
+/**
+ * @file    GSCA/RegisterLog.h
+ * @brief   A log of timestamped writes to the APU's hardware registers.
+ */
+
+#pragma once
+#include <GSCA/Common.h>
+
+/* Typedefs and Forward Declarations ******************************************/
+
+typedef struct gscaRegisterLog gscaRegisterLog;
+
+/* Register Log Entry Structure ***********************************************/
+
+/**
+ * @brief   A single write to one of the APU's hardware registers.
+ */
+typedef struct
+{
+    uint64_t    cycle;      ///< @brief The APU clock cycle on which the write was made.
+    uint8_t     address;    ///< @brief The register's address, relative to `$FF00`.
+    uint8_t     value;      ///< @brief The value written to the register.
+} gscaRegisterLogEntry;
+
+/* Public Function Prototypes *************************************************/
+
+/**
+ * @brief   Creates a new, empty register log.
+ *
+ * The log's entries are stored in fixed-size blocks, which are allocated as
+ * the log grows and kept when it is cleared, so appending an entry never moves
+ * the entries before it.
+ *
+ * @return  A pointer to the new register log.
+ */
+GSCA_API gscaRegisterLog* gscaCreateRegisterLog ();
+
+/**
+ * @brief   Destroys the given register log.
+ *
+ * @param   log     A pointer to the register log.
+ */
+GSCA_API void gscaDestroyRegisterLog (gscaRegisterLog* log);
+
+/**
+ * @brief   Removes all entries from the given register log.
+ *
+ * @param   log     A pointer to the register log.
+ */
+GSCA_API void gscaClearRegisterLog (gscaRegisterLog* log);
+
+/**
+ * @brief   Appends a register write to the end of the given register log.
+ *
+ * @param   log     A pointer to the register log.
+ * @param   cycle   The APU clock cycle on which the write was made. This should
+ *                  be no earlier than that of the log's last entry.
+ * @param   address The register's address, relative to `$FF00`.
+ * @param   value   The value written to the register.
+ */
+GSCA_API void gscaAppendRegisterLog (gscaRegisterLog* log, uint64_t cycle, uint8_t address,
+    uint8_t value);
+
+/**
+ * @brief   Retrieves the number of entries in the given register log.
+ *
+ * @param   log     A pointer to the register log.
+ *
+ * @return  The number of entries in the log.
+ */
+GSCA_API size_t gscaGetRegisterLogSize (const gscaRegisterLog* log);
+
+/**
+ * @brief   Retrieves an entry from the given register log.
+ *
+ * @param   log     A pointer to the register log.
+ * @param   index   The index of the entry.
+ *
+ * @return  A pointer to the entry, or `NULL` if the index is out of range.
+ */
+GSCA_API const gscaRegisterLogEntry* gscaGetRegisterLogEntry (const gscaRegisterLog* log,
+    size_t index);
+
+/**
+ * @brief   Reads register writes from a binary register log file, appending
+ *          them to the given register log.
+ *
+ * The file's cycles are counted from the cycle of the log's last entry, or
+ * from zero if the log is empty, so that several files read into one log play
+ * back to back. If the file cannot be read in full, the log is left unchanged.
+ *
+ * @param   log         A pointer to the register log.
+ * @param   filename    The name of the file to read.
+ *
+ * @return  `true` if the file was read, `false` if not.
+ */
+GSCA_API bool gscaReadRegisterLogFile (gscaRegisterLog* log, const char* filename);
+
+/**
+ * @brief   Writes the given register log to a binary register log file.
+ *
+ * Each entry is stored as the number of cycles since the previous entry, as a
+ * variable-length integer, followed by the register's address and value, so a
+ * typical entry takes two to four bytes.
+ *
+ * @param   log         A pointer to the register log.
+ * @param   filename    The name of the file to write.
+ *
+ * @return  `true` if the file was written, `false` if not.
+ */
+GSCA_API bool gscaWriteRegisterLogFile (const gscaRegisterLog* log, const char* filename);
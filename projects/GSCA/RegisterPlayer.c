@@ -0,0 +1,95 @@
+/**
+ * @file    GSCA/RegisterPlayer.c
+ */
+
+#include <GSCA/APU.h>
+#include <GSCA/RegisterPlayer.h>
+
+/* Register Player Structure **************************************************/
+
+typedef struct gscaRegisterPlayer
+{
+    gscaAPU*                apu;
+    const gscaRegisterLog*  log;
+    size_t                  position;
+    uint64_t                startCycle;
+} gscaRegisterPlayer;
+
+/* Public Functions ***********************************************************/
+
+gscaRegisterPlayer* gscaCreateRegisterPlayer (gscaAPU* apu, const gscaRegisterLog* log)
+{
+    gscaExpect(apu, "Pointer 'apu' is NULL!\n");
+    gscaExpect(log, "Pointer 'log' is NULL!\n");
+
+    gscaRegisterPlayer* player = gscaCreateZero(1, gscaRegisterPlayer);
+    gscaExpectp(player, "Could not allocate register player structure");
+
+    player->apu = apu;
+    player->log = log;
+    gscaRestartRegisterPlayer(player);
+
+    return player;
+}
+
+void gscaDestroyRegisterPlayer (gscaRegisterPlayer* player)
+{
+    if (player != NULL)
+    {
+        player->apu = NULL;
+        player->log = NULL;
+        gscaDestroy(player);
+    }
+}
+
+void gscaRestartRegisterPlayer (gscaRegisterPlayer* player)
+{
+    gscaExpect(player, "Pointer 'player' is NULL!\n");
+    player->position = 0;
+    player->startCycle = gscaGetAPUCycles(player->apu);
+}
+
+bool gscaIsRegisterPlayerFinished (const gscaRegisterPlayer* player)
+{
+    gscaExpect(player, "Pointer 'player' is NULL!\n");
+    return player->position >= gscaGetRegisterLogSize(player->log);
+}
+
+size_t gscaRenderRegisterPlayer (gscaRegisterPlayer* player, gscaAudioSample* out,
+    size_t frameCount)
+{
+    gscaExpect(player, "Pointer 'player' is NULL!\n");
+    gscaExpect(out != NULL || frameCount == 0, "Pointer 'out' is NULL!\n");
+
+    gscaAPU* apu = player->apu;
+    size_t logSize = gscaGetRegisterLogSize(player->log);
+    size_t frames = 0;
+
+    while (frames < frameCount)
+    {
+        // Make every write which is due on the current cycle, then run the APU
+        // up to the cycle of the next one.
+        uint64_t cycle = gscaGetAPUCycles(apu);
+        const gscaRegisterLogEntry* entry = NULL;
+        while (player->position < logSize)
+        {
+            entry = gscaGetRegisterLogEntry(player->log, player->position);
+            if (player->startCycle + entry->cycle > cycle)
+                { break; }
+
+            gscaWriteRegister(apu, entry->address, entry->value);
+            player->position++;
+        }
+
+        if (player->position >= logSize)
+        {
+            frames += gscaRenderAPU(apu, out + frames, frameCount - frames);
+            break;
+        }
+
+        frames += gscaRenderAPUUntil(apu, out + frames, frameCount - frames,
+            player->startCycle + entry->cycle);
+    }
+
+    return frames;
+}
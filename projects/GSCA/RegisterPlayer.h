@@ -0,0 +1,72 @@
+/**
+ * @file    GSCA/RegisterPlayer.h
+ * @brief   Plays back a register log by writing it straight into the APU.
+ */
+
+#pragma once
+#include <GSCA/RegisterLog.h>
+
+/* Typedefs and Forward Declarations ******************************************/
+
+typedef struct gscaAPU              gscaAPU;
+typedef struct gscaRegisterPlayer   gscaRegisterPlayer;
+
+/* Public Function Prototypes *************************************************/
+
+/**
+ * @brief   Creates a player which plays back the given register log on the
+ *          given APU.
+ *
+ * The log's cycles are taken to be relative to the start of playback, which is
+ * the APU's current cycle; so a log captured from an APU which was just reset
+ * should be played back on an APU which was just reset. The log is not owned by
+ * the player, and must not be changed while it is being played back.
+ *
+ * @param   apu     A pointer to the GSCA APU emulation context.
+ * @param   log     A pointer to the register log to play back.
+ *
+ * @return  A pointer to the new register player.
+ */
+GSCA_API gscaRegisterPlayer* gscaCreateRegisterPlayer (gscaAPU* apu,
+    const gscaRegisterLog* log);
+
+/**
+ * @brief   Destroys the given register player.
+ *
+ * @param   player  A pointer to the register player.
+ */
+GSCA_API void gscaDestroyRegisterPlayer (gscaRegisterPlayer* player);
+
+/**
+ * @brief   Restarts playback of the register log from its first entry, at the
+ *          APU's current cycle.
+ *
+ * @param   player  A pointer to the register player.
+ */
+GSCA_API void gscaRestartRegisterPlayer (gscaRegisterPlayer* player);
+
+/**
+ * @brief   Checks whether every entry in the register log has been played back.
+ *
+ * @param   player  A pointer to the register player.
+ *
+ * @return  `true` if playback has finished, `false` if not.
+ */
+GSCA_API bool gscaIsRegisterPlayerFinished (const gscaRegisterPlayer* player);
+
+/**
+ * @brief   Runs the APU until the given number of audio samples have been
+ *          output, making each of the register log's writes on the cycle it is
+ *          due.
+ *
+ * Once playback has finished, the APU keeps running as @a gscaRenderAPU would.
+ *
+ * @param   player      A pointer to the register player.
+ * @param   out         A pointer to an interleaved stereo buffer with room for
+ *                      at least `frameCount` samples.
+ * @param   frameCount  The number of audio samples to output.
+ *
+ * @return  The number of audio samples written to the buffer.
+ */
+GSCA_API size_t gscaRenderRegisterPlayer (gscaRegisterPlayer* player, gscaAudioSample* out,
+    size_t frameCount);
@@ -803,6 +803,14 @@ void gscabShutdownBuilder ()
 {
     gscaDestroy(builder.binary);
     gscaDestroy(builder.labels);
+
+    builder.parentLabelText[0]  = '\0';
+    builder.labelCount          = 0;
+    builder.labelCapacity       = 0;
+    builder.binarySize          = 0;
+    builder.binaryPointer       = 0;
+    builder.audioCount          = 0;
+    builder.channelCount        = 0;
 }
 
 bool gscabBuilderPassOne ()
@@ -225,6 +225,10 @@ void gscabShutdownLexer()
 {
     gscabClearSource();
     gscaDestroy(lexer.tokens);
+
+    lexer.tokenSize     = 0;
+    lexer.tokenCapacity = 0;
+    lexer.tokenPointer  = 0;
 }
 
 void gscabClearSource ()
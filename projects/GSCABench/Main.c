@@ -0,0 +1,701 @@
+/**
+ * @file    GSCABench/Main.c
+ */
+
+#include <GSCA/GSCA.h>
+#include <GSCAB/Lexer.h>
+#include <GSCAB/Builder.h>
+
+/* Constant Macros ************************************************************/
+
+#define GSCABENCH_MAX_RESULTS       300
+#define GSCABENCH_NAME_STRLEN       64
+#define GSCABENCH_TICK_SECONDS      10
+#define GSCABENCH_RENDER_SECONDS    120
+#define GSCABENCH_LOAD_ITERATIONS   200
+#define GSCABENCH_BUILD_ITERATIONS  5
+
+/* Result Structure ***********************************************************/
+
+typedef struct
+{
+    char    name[GSCABENCH_NAME_STRLEN];
+    char    metric[GSCABENCH_NAME_STRLEN];
+    double  value;
+} gscabenchResult;
+
+/* Benchmark Context **********************************************************/
+
+static struct
+{
+    gscabenchResult results[GSCABENCH_MAX_RESULTS];
+    size_t          resultCount;
+    bool            csv;
+} bench = {
+    .resultCount    = 0,
+    .csv            = false
+};
+
+/* Private Functions **********************************************************/
+
+static double gscabenchNow ()
+{
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void gscabenchReport (const char* name, const char* metric, double value)
+{
+    if (bench.resultCount < GSCABENCH_MAX_RESULTS)
+    {
+        gscabenchResult* result = &bench.results[bench.resultCount++];
+        gscaCopyString(result->name, name, GSCABENCH_NAME_STRLEN);
+        gscaCopyString(result->metric, metric, GSCABENCH_NAME_STRLEN);
+        result->value = value;
+    }
+}
+
+static void gscabenchPrintResults ()
+{
+    if (bench.csv == true)
+    {
+        printf("name,metric,value\n");
+        for (size_t i = 0; i < bench.resultCount; ++i)
+        {
+            const gscabenchResult* result = &bench.results[i];
+            printf("%s,%s,%.6g\n", result->name, result->metric, result->value);
+        }
+    }
+    else
+    {
+        printf("{\n    \"benchmarks\": [\n");
+        for (size_t i = 0; i < bench.resultCount; ++i)
+        {
+            const gscabenchResult* result = &bench.results[i];
+            printf("        { \"name\": \"%s\", \"metric\": \"%s\", \"value\": %.6g }%s\n",
+                result->name, result->metric, result->value,
+                (i + 1 < bench.resultCount) ? "," : "");
+        }
+        printf("    ]\n}\n");
+    }
+}
+
+static gscaAudioEngine* gscabenchPlaySong (gscaAPU* apu, gscaAudioStore* store,
+    const char* filename, const char* song)
+{
+    if (gscaReadAudioFile(store, filename) == false)
+    {
+        return nullptr;
+    }
+
+    gscaAudioEngine* engine = gscaCreateAudioEngine(apu, store);
+    if (gscaPlayMusic(engine, song) == false)
+    {
+        gscaDestroyAudioEngine(engine);
+        return nullptr;
+    }
+
+    return engine;
+}
+
+static bool gscabenchTickAPU (const char* filename, const char* song)
+{
+    // Record the audio engine's register writes up front, clocking the APU one
+    // cycle at a time and updating the engine once every engine frame, as a
+    // caller of `gscaTickAPU` would, so that only the APU is timed below.
+    gscaAPU* apu = gscaCreateAPU(GSCA_ACC_EXACT);
+    gscaRegisterLog* log = gscaCreateRegisterLog();
+    gscaSetAPURegisterLog(apu, log);
+
+    gscaAudioStore* store = gscaCreateAudioStore(GSCA_AS_DEFAULT_CAPACITY);
+    gscaAudioEngine* engine = gscabenchPlaySong(apu, store, filename, song);
+    if (engine == nullptr)
+    {
+        gscaDestroyAudioStore(store);
+        gscaDestroyRegisterLog(log);
+        gscaDestroyAPU(apu);
+        return false;
+    }
+
+    size_t engineFrames = GSCABENCH_TICK_SECONDS * GSCA_CLOCK_RATE / GSCA_UPDATE_INTERVAL;
+    for (size_t i = 0; i < engineFrames; ++i)
+    {
+        for (size_t j = 0; j < GSCA_UPDATE_INTERVAL; ++j)
+        {
+            gscaTickAPU(apu);
+        }
+
+        gscaUpdateAudioEngine(engine);
+    }
+    gscaSetAPURegisterLog(apu, nullptr);
+    gscaDestroyAudioEngine(engine);
+    gscaResetAPU(apu);
+
+    // Play the recorded writes back at the end of each engine frame.
+    size_t entry = 0, entryCount = gscaGetRegisterLogSize(log);
+    double start = gscabenchNow();
+    for (size_t i = 0; i < engineFrames; ++i)
+    {
+        for (size_t j = 0; j < GSCA_UPDATE_INTERVAL; ++j)
+        {
+            gscaTickAPU(apu);
+        }
+
+        for (; entry < entryCount; ++entry)
+        {
+            const gscaRegisterLogEntry* write = gscaGetRegisterLogEntry(log, entry);
+            if (write->cycle > gscaGetAPUCycles(apu)) { break; }
+            gscaWriteRegister(apu, write->address, write->value);
+        }
+    }
+    double elapsed = gscabenchNow() - start;
+
+    gscabenchReport("apu_tick", "cycles_per_second",
+        (double) engineFrames * GSCA_UPDATE_INTERVAL / elapsed);
+
+    gscaDestroyRegisterLog(log);
+    gscaDestroyAudioStore(store);
+    gscaDestroyAPU(apu);
+    return true;
+}
+
+static bool gscabenchRenderSong (const char* filename, const char* song,
+    gscaAccuracy accuracy, const char* name)
+{
+    gscaAPU* apu = gscaCreateAPU(accuracy);
+    gscaAudioStore* store = gscaCreateAudioStore(GSCA_AS_DEFAULT_CAPACITY);
+    gscaAudioEngine* engine = gscabenchPlaySong(apu, store, filename, song);
+    if (engine == nullptr)
+    {
+        gscaDestroyAudioStore(store);
+        gscaDestroyAPU(apu);
+        return false;
+    }
+
+    // Render one engine frame's worth of audio samples at a time, carrying
+    // over the phase which falls short of a whole sample, as the player does.
+    static gscaAudioSample buffer[4096];
+    uint32_t sampleRate = gscaGetAPUSampleRate(apu);
+    size_t engineFrames = GSCABENCH_RENDER_SECONDS * GSCA_CLOCK_RATE / GSCA_UPDATE_INTERVAL;
+    uint64_t samplePhase = 0, frames = 0;
+
+#if defined(GSCA_PROFILE)
+    gscaResetCommandProfile(engine);
+#endif
+
+    double start = gscabenchNow();
+    for (size_t i = 0; i < engineFrames; ++i)
+    {
+        samplePhase += (uint64_t) GSCA_UPDATE_INTERVAL * sampleRate;
+        frames += gscaRenderAPU(apu, buffer, samplePhase / GSCA_CLOCK_RATE);
+        samplePhase %= GSCA_CLOCK_RATE;
+
+        gscaUpdateAudioEngine(engine);
+    }
+    double elapsed = gscabenchNow() - start;
+
+    gscabenchReport(name, "frames_per_second", frames / elapsed);
+    gscabenchReport(name, "realtime_factor", ((double) frames / sampleRate) / elapsed);
+
+#if defined(GSCA_PROFILE)
+    for (size_t opcode = 0; opcode < 256 && accuracy == GSCA_ACC_EXACT; ++opcode)
+    {
+        const gscaCommandProfile* profile = gscaGetCommandProfile(engine, opcode);
+        if (profile->count > 0)
+        {
+            char name[GSCABENCH_NAME_STRLEN];
+            snprintf(name, GSCABENCH_NAME_STRLEN, "parse_command_%02zx", opcode);
+            gscabenchReport(name, "calls", profile->count);
+            gscabenchReport(name, "ns_per_call",
+                (double) profile->nanoseconds / profile->count);
+        }
+    }
+#endif
+
+    gscaDestroyAudioEngine(engine);
+    gscaDestroyAudioStore(store);
+    gscaDestroyAPU(apu);
+    return true;
+}
+
+static bool gscabenchRenderEngine (const char* filename, const char* song)
+{
+    gscaAPU* apu = gscaCreateAPU(GSCA_ACC_EXACT);
+    gscaAudioStore* store = gscaCreateAudioStore(GSCA_AS_DEFAULT_CAPACITY);
+    gscaAudioEngine* engine = gscabenchPlaySong(apu, store, filename, song);
+    if (engine == nullptr)
+    {
+        gscaDestroyAudioStore(store);
+        gscaDestroyAPU(apu);
+        return false;
+    }
+
+    // Render fixed-size blocks of audio samples, leaving the audio engine's
+    // updates to the render call, as a streaming host would.
+    static gscaAudioSample buffer[4096];
+    uint32_t sampleRate = gscaGetAPUSampleRate(apu);
+    uint64_t frameCount = (uint64_t) GSCABENCH_RENDER_SECONDS * sampleRate, frames = 0;
+
+    double start = gscabenchNow();
+    while (frames < frameCount)
+    {
+        size_t count = (frameCount - frames < 1024) ? frameCount - frames : 1024;
+        frames += gscaRenderEngine(engine, buffer, count);
+    }
+    double elapsed = gscabenchNow() - start;
+
+    gscabenchReport("render_engine", "frames_per_second", frames / elapsed);
+    gscabenchReport("render_engine", "realtime_factor",
+        ((double) frames / sampleRate) / elapsed);
+
+    gscaDestroyAudioEngine(engine);
+    gscaDestroyAudioStore(store);
+    gscaDestroyAPU(apu);
+    return true;
+}
+
+static bool gscabenchRenderStream (const char* filename, const char* song)
+{
+    gscaAPU* apu = gscaCreateAPU(GSCA_ACC_EXACT);
+    gscaAudioStore* store = gscaCreateAudioStore(GSCA_AS_DEFAULT_CAPACITY);
+    gscaAudioEngine* engine = gscabenchPlaySong(apu, store, filename, song);
+    if (engine == nullptr)
+    {
+        gscaDestroyAudioStore(store);
+        gscaDestroyAPU(apu);
+        return false;
+    }
+
+    // Capture the song's register writes, then play them back on a fresh APU
+    // without the audio engine, timing only the playback.
+    static gscaAudioSample buffer[4096];
+    uint32_t sampleRate = gscaGetAPUSampleRate(apu);
+    size_t engineFrames = GSCABENCH_RENDER_SECONDS * GSCA_CLOCK_RATE / GSCA_UPDATE_INTERVAL;
+    uint64_t samplePhase = 0, frames = 0;
+
+    gscaRegisterLog* log = gscaCreateRegisterLog();
+    gscaSetAPURegisterLog(apu, log);
+    for (size_t i = 0; i < engineFrames; ++i)
+    {
+        samplePhase += (uint64_t) GSCA_UPDATE_INTERVAL * sampleRate;
+        frames += gscaRenderAPU(apu, buffer, samplePhase / GSCA_CLOCK_RATE);
+        samplePhase %= GSCA_CLOCK_RATE;
+
+        gscaUpdateAudioEngine(engine);
+    }
+    gscaSetAPURegisterLog(apu, nullptr);
+
+    gscaAPU* streamAPU = gscaCreateAPU(GSCA_ACC_EXACT);
+    gscaRegisterPlayer* player = gscaCreateRegisterPlayer(streamAPU, log);
+    size_t blockSize = sampleRate * GSCA_UPDATE_INTERVAL / GSCA_CLOCK_RATE;
+
+    double start = gscabenchNow();
+    for (uint64_t rendered = 0; rendered < frames; )
+    {
+        size_t count = (frames - rendered < blockSize) ? frames - rendered : blockSize;
+        rendered += gscaRenderRegisterPlayer(player, buffer, count);
+    }
+    double elapsed = gscabenchNow() - start;
+
+    gscabenchReport("render_stream", "frames_per_second", frames / elapsed);
+    gscabenchReport("render_stream", "realtime_factor",
+        ((double) frames / sampleRate) / elapsed);
+    gscabenchReport("render_stream", "register_writes", gscaGetRegisterLogSize(log));
+
+    gscaDestroyRegisterPlayer(player);
+    gscaDestroyAPU(streamAPU);
+    gscaDestroyRegisterLog(log);
+    gscaDestroyAudioEngine(engine);
+    gscaDestroyAudioStore(store);
+    gscaDestroyAPU(apu);
+    return true;
+}
+
+static bool gscabenchRenderTaps (const char* filename, const char* song)
+{
+    gscaAPU* apu = gscaCreateAPU(GSCA_ACC_EXACT);
+    gscaAudioStore* store = gscaCreateAudioStore(GSCA_AS_DEFAULT_CAPACITY);
+    gscaAudioEngine* engine = gscabenchPlaySong(apu, store, filename, song);
+    if (engine == nullptr)
+    {
+        gscaDestroyAudioStore(store);
+        gscaDestroyAPU(apu);
+        return false;
+    }
+
+    // Render the song at the streaming tier's three sample rates at once, one
+    // engine frame at a time, from a single run of the channel emulation.
+    static const uint32_t RATES[] = { 44100, 48000, 22050 };
+    static gscaAudioSample buffers[3][4096];
+    gscaAudioSample* out[3] = { buffers[0], buffers[1], buffers[2] };
+    size_t engineFrames = GSCABENCH_RENDER_SECONDS * GSCA_CLOCK_RATE / GSCA_UPDATE_INTERVAL;
+    uint64_t frames = 0;
+
+    gscaSetAPUOutputTaps(apu, RATES, 3);
+
+    double start = gscabenchNow();
+    for (size_t i = 0; i < engineFrames; ++i)
+    {
+        size_t frameCounts[3] = { 4096, 4096, 4096 };
+        gscaRenderAPUTaps(apu, out, frameCounts, GSCA_UPDATE_INTERVAL);
+        frames += frameCounts[0] + frameCounts[1] + frameCounts[2];
+
+        gscaUpdateAudioEngine(engine);
+    }
+    double elapsed = gscabenchNow() - start;
+
+    gscabenchReport("render_taps", "frames_per_second", frames / elapsed);
+    gscabenchReport("render_taps", "realtime_factor",
+        ((double) engineFrames * GSCA_UPDATE_INTERVAL / GSCA_CLOCK_RATE) / elapsed);
+
+    gscaDestroyAudioEngine(engine);
+    gscaDestroyAudioStore(store);
+    gscaDestroyAPU(apu);
+    return true;
+}
+
+static void gscabenchStartTone (gscaAPU* apu, gscaAudioChannel channel)
+{
+    static const gscaRegisterWrite TONES[][5] = {
+        [GSCA_AC_PULSE1] = {
+            { GSCA_AR_NR11, 0x80 }, { GSCA_AR_NR12, 0xF0 }, { GSCA_AR_NR13, 0x00 },
+            { GSCA_AR_NR14, 0x87 }
+        },
+        [GSCA_AC_PULSE2] = {
+            { GSCA_AR_NR21, 0x40 }, { GSCA_AR_NR22, 0xA3 }, { GSCA_AR_NR23, 0x40 },
+            { GSCA_AR_NR24, 0x86 }
+        },
+        [GSCA_AC_WAVE] = {
+            { GSCA_AR_NR30, 0x80 }, { GSCA_AR_NR32, 0x20 }, { GSCA_AR_NR33, 0x10 },
+            { GSCA_AR_NR34, 0x86 }
+        },
+        [GSCA_AC_NOISE] = {
+            { GSCA_AR_NR42, 0xF1 }, { GSCA_AR_NR43, 0x65 }, { GSCA_AR_NR44, 0x80 }
+        }
+    };
+
+    gscaWriteRegister(apu, GSCA_AR_NR52, 0x80);
+    gscaWriteRegister(apu, GSCA_AR_NR50, 0x77);
+    gscaWriteRegister(apu, GSCA_AR_NR51, 0xFF);
+    gscaSetWavePattern(apu, "0123456789ABCDEFFEDCBA9876543210");
+
+    for (size_t i = 0; i < 5 && TONES[channel][i].address != 0; ++i)
+    {
+        gscaWriteRegister(apu, TONES[channel][i].address, TONES[channel][i].value);
+    }
+}
+
+static bool gscabenchCompareBatch ()
+{
+    // Play a tone on each channel in its own lane of a batch, and check each
+    // lane's output against a lone APU playing the same tone.
+    static gscaAudioSample buffers[GSCA_AUDIO_CHANNEL_COUNT][GSCA_DEFAULT_SAMPLE_RATE];
+    static gscaAudioSample expected[GSCA_DEFAULT_SAMPLE_RATE];
+    static const char* NAMES[GSCA_AUDIO_CHANNEL_COUNT] = {
+        "apu_batch_pulse1", "apu_batch_pulse2", "apu_batch_wave", "apu_batch_noise"
+    };
+
+    gscaAPUBatch* batch = gscaCreateAPUBatch(GSCA_AUDIO_CHANNEL_COUNT);
+    gscaAudioSample* out[GSCA_AUDIO_CHANNEL_COUNT];
+    for (gscaEnum c = 0; c < GSCA_AUDIO_CHANNEL_COUNT; ++c)
+    {
+        gscabenchStartTone(gscaGetAPUBatchLane(batch, c), c);
+        out[c] = buffers[c];
+    }
+
+    size_t frames = gscaRenderAPUBatch(batch, out, GSCA_DEFAULT_SAMPLE_RATE);
+    bool ok = true;
+
+    for (gscaEnum c = 0; c < GSCA_AUDIO_CHANNEL_COUNT; ++c)
+    {
+        gscaAPU* apu = gscaCreateAPU(GSCA_ACC_EXACT);
+        gscabenchStartTone(apu, c);
+        gscaRenderAPU(apu, expected, frames);
+        gscaDestroyAPU(apu);
+
+        size_t mismatches = 0;
+        for (size_t i = 0; i < frames; ++i)
+        {
+            if (
+                buffers[c][i].left != expected[i].left ||
+                buffers[c][i].right != expected[i].right
+            )
+            {
+                mismatches++;
+            }
+        }
+
+        gscabenchReport(NAMES[c], "mismatched_frames", mismatches);
+        if (mismatches > 0)
+        {
+            fprintf(stderr, "APU batch lane '%s' does not match gscaRenderAPU.\n", NAMES[c]);
+            ok = false;
+        }
+    }
+
+    gscaDestroyAPUBatch(batch);
+    return ok;
+}
+
+static bool gscabenchResetBatchLane ()
+{
+    // Reset one lane of a batch half-way through, as a caller restarting one
+    // stream would. The reset lane must fall silent, and the other must carry
+    // on as a lone APU would.
+    static gscaAudioSample buffers[2][GSCA_DEFAULT_SAMPLE_RATE];
+    static gscaAudioSample expected[GSCA_DEFAULT_SAMPLE_RATE];
+    const size_t half = GSCA_DEFAULT_SAMPLE_RATE / 2;
+
+    gscaAPUBatch* batch = gscaCreateAPUBatch(2);
+    gscabenchStartTone(gscaGetAPUBatchLane(batch, 0), GSCA_AC_PULSE1);
+    gscabenchStartTone(gscaGetAPUBatchLane(batch, 1), GSCA_AC_PULSE2);
+
+    gscaAudioSample* out[2] = { buffers[0], buffers[1] };
+    size_t frames = gscaRenderAPUBatch(batch, out, half);
+    gscaResetAPU(gscaGetAPUBatchLane(batch, 0));
+    out[0] += frames; out[1] += frames;
+    frames += gscaRenderAPUBatch(batch, out, GSCA_DEFAULT_SAMPLE_RATE - half);
+
+    gscaAPU* apu = gscaCreateAPU(GSCA_ACC_EXACT);
+    gscabenchStartTone(apu, GSCA_AC_PULSE2);
+    gscaRenderAPU(apu, expected, GSCA_DEFAULT_SAMPLE_RATE);
+    gscaDestroyAPU(apu);
+
+    size_t mismatches = GSCA_DEFAULT_SAMPLE_RATE - frames;
+    for (size_t i = 0; i < frames; ++i)
+    {
+        if (
+            buffers[1][i].left != expected[i].left ||
+            buffers[1][i].right != expected[i].right ||
+            (i >= half && (buffers[0][i].left != 0.0f || buffers[0][i].right != 0.0f))
+        )
+        {
+            mismatches++;
+        }
+    }
+
+    gscaDestroyAPUBatch(batch);
+
+    gscabenchReport("apu_batch_reset_lane", "mismatched_frames", mismatches);
+    if (mismatches > 0)
+    {
+        fprintf(stderr, "APU batch did not recover from a lane being reset.\n");
+        return false;
+    }
+
+    return true;
+}
+
+static bool gscabenchCheckRegisterLogFile ()
+{
+    // Write a short register log to a file, and a copy of it cut short, then
+    // read both into a log which already holds entries.
+    static const char* FILENAME = "gscabench_registers.bin";
+    static const char* TRUNCATED_FILENAME = "gscabench_registers_truncated.bin";
+    gscaRegisterLog* log = gscaCreateRegisterLog();
+    for (size_t i = 0; i < 100; ++i)
+    {
+        gscaAppendRegisterLog(log, 1000 + i * 300, GSCA_AR_NR12, i & 0xFF);
+    }
+
+    bool written = gscaWriteRegisterLogFile(log, FILENAME);
+    FILE* in = fopen(FILENAME, "rb");
+    FILE* out = fopen(TRUNCATED_FILENAME, "wb");
+    if (written == false || in == NULL || out == NULL)
+    {
+        if (in != NULL) { fclose(in); }
+        if (out != NULL) { fclose(out); }
+        gscaDestroyRegisterLog(log);
+        return false;
+    }
+
+    uint8_t data[1024];
+    size_t size = fread(data, sizeof(uint8_t), sizeof(data), in);
+    fwrite(data, sizeof(uint8_t), size - 1, out);
+    fclose(in);
+    fclose(out);
+
+    // The truncated file must leave the log untouched. The whole file must
+    // follow on from the log's last entry.
+    size_t failures = 0;
+    if (gscaReadRegisterLogFile(log, TRUNCATED_FILENAME) == true) { failures++; }
+    if (gscaGetRegisterLogSize(log) != 100) { failures++; }
+    if (gscaReadRegisterLogFile(log, FILENAME) == false) { failures++; }
+    if (gscaGetRegisterLogSize(log) != 200) { failures++; }
+
+    for (size_t i = 1; i < gscaGetRegisterLogSize(log); ++i)
+    {
+        if (gscaGetRegisterLogEntry(log, i)->cycle < gscaGetRegisterLogEntry(log, i - 1)->cycle)
+        {
+            failures++;
+        }
+    }
+
+    remove(FILENAME);
+    remove(TRUNCATED_FILENAME);
+    gscaDestroyRegisterLog(log);
+
+    gscabenchReport("register_log_file", "failed_checks", failures);
+    if (failures > 0)
+    {
+        fprintf(stderr, "Register log file did not read back as expected.\n");
+        return false;
+    }
+
+    return true;
+}
+
+static bool gscabenchLoadBank (const char* filename)
+{
+    double elapsed = 0.0;
+    size_t bytes = 0;
+
+    for (size_t i = 0; i < GSCABENCH_LOAD_ITERATIONS; ++i)
+    {
+        gscaAudioStore* store = gscaCreateAudioStore(GSCA_AS_DEFAULT_CAPACITY);
+
+        double start = gscabenchNow();
+        bool ok = gscaReadAudioFile(store, filename);
+        elapsed += gscabenchNow() - start;
+
+        bytes = gscaGetAudioDataSize(store);
+        gscaDestroyAudioStore(store);
+        if (ok == false) { return false; }
+    }
+
+    gscabenchReport("load_bank", "ms_per_load", elapsed * 1000.0 / GSCABENCH_LOAD_ITERATIONS);
+    gscabenchReport("load_bank", "bytes_per_second",
+        (double) bytes * GSCABENCH_LOAD_ITERATIONS / elapsed);
+    return true;
+}
+
+static size_t gscabenchSourceSize (const char* path)
+{
+    char** sources = PHYSFS_enumerateFiles(path);
+    if (sources == nullptr) { return 0; }
+
+    size_t size = 0;
+    for (char** i = sources; *i != NULL; ++i)
+    {
+        PHYSFS_Stat stat;
+        if (PHYSFS_stat(*i, &stat) && stat.filetype == PHYSFS_FILETYPE_REGULAR)
+        {
+            size += stat.filesize;
+        }
+    }
+
+    PHYSFS_freeList(sources);
+    return size;
+}
+
+static bool gscabenchBuildBank (const char* arg0, const char* folder)
+{
+    if (!PHYSFS_init(arg0))
+    {
+        gscaErr("Could not initialize PHYSFS: '%s'!\n", gscabPhysfsErr());
+        return false;
+    }
+    else if (!PHYSFS_mount(folder, nullptr, 1))
+    {
+        gscaErr("Could not mount provided folder '%s': '%s'!\n", folder,
+            gscabPhysfsErr());
+        PHYSFS_deinit();
+        return false;
+    }
+
+    double lexTime = 0.0, passOneTime = 0.0, passTwoTime = 0.0;
+    size_t tokens = 0;
+    bool ok = true;
+
+    for (size_t i = 0; i < GSCABENCH_BUILD_ITERATIONS && ok == true; ++i)
+    {
+        gscabInitLexer();
+        gscabInitBuilder();
+
+        double start = gscabenchNow();
+        ok = gscabLexFolder("/");
+        double lexed = gscabenchNow();
+        ok = ok && gscabBuilderPassOne();
+        double passedOne = gscabenchNow();
+        ok = ok && gscabBuilderPassTwo();
+        double passedTwo = gscabenchNow();
+
+        lexTime += lexed - start;
+        passOneTime += passedOne - lexed;
+        passTwoTime += passedTwo - passedOne;
+
+        tokens = 0;
+        gscabResetPointer();
+        while (gscabNextToken() != nullptr) { tokens++; }
+
+        gscabShutdownBuilder();
+        gscabShutdownLexer();
+    }
+
+    if (ok == true)
+    {
+        double bytes = (double) gscabenchSourceSize("/") * GSCABENCH_BUILD_ITERATIONS;
+        double count = (double) tokens * GSCABENCH_BUILD_ITERATIONS;
+        gscabenchReport("build_lex", "bytes_per_second", bytes / lexTime);
+        gscabenchReport("build_lex", "tokens_per_second", count / lexTime);
+        gscabenchReport("build_pass_one", "tokens_per_second", count / passOneTime);
+        gscabenchReport("build_pass_two", "tokens_per_second", count / passTwoTime);
+        gscabenchReport("build_total", "ms_per_build",
+            (lexTime + passOneTime + passTwoTime) * 1000.0 / GSCABENCH_BUILD_ITERATIONS);
+    }
+    else
+    {
+        gscaErr("Could not build audio bank from folder '%s'.\n", folder);
+    }
+
+    PHYSFS_deinit();
+    return ok;
+}
+
+/* Public Functions ***********************************************************/
+
+int main (int argc, char** argv)
+{
+    const char* arguments[3] = { nullptr, nullptr, nullptr };
+    int argumentCount = 0;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "--csv") == 0)  { bench.csv = true; }
+        else if (argumentCount < 3)         { arguments[argumentCount++] = argv[i]; }
+    }
+
+    if (argumentCount < 2)
+    {
+        printf("Usage: %s <file> <song> [source folder] [--csv]\n", argv[0]);
+        return 0;
+    }
+
+    if (
+        gscabenchTickAPU(arguments[0], arguments[1]) == false ||
+        gscabenchRenderSong(arguments[0], arguments[1], GSCA_ACC_EXACT, "render_song") == false ||
+        gscabenchRenderSong(arguments[0], arguments[1], GSCA_ACC_PREVIEW,
+            "render_song_preview") == false ||
+        gscabenchRenderEngine(arguments[0], arguments[1]) == false ||
+        gscabenchRenderStream(arguments[0], arguments[1]) == false ||
+        gscabenchRenderTaps(arguments[0], arguments[1]) == false ||
+        gscabenchCompareBatch() == false ||
+        gscabenchResetBatchLane() == false ||
+        gscabenchCheckRegisterLogFile() == false ||
+        gscabenchLoadBank(arguments[0]) == false
+    )
+    {
+        fprintf(stderr, "Could not benchmark song '%s' from file '%s'.\n",
+            arguments[1], arguments[0]);
+        return 1;
+    }
+
+    if (arguments[2] != nullptr && gscabenchBuildBank(argv[0], arguments[2]) == false)
+    {
+        return 2;
+    }
+
+    gscabenchPrintResults();
+    return 0;
+}
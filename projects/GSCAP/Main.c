@@ -7,11 +7,14 @@ static gscaAudioEngine*     engine = nullptr;
 static SDL_Window*          window = nullptr;
 static SDL_Renderer*        renderer = nullptr;
 static SDL_AudioDeviceID    audioDevice = 0;
-static float                audioBuffer[8192] = { 0 };
-static uint16_t             audioCursor = 0;
+static gscaAudioSampleS16   audioBuffer[1024] = { 0 };
 static bool                 running = true;
-static uint32_t             ticks = 0;
 static uint16_t             handle = 0;
+static const gscaOutputFormat audioFormat = {
+    .type   = GSCA_ST_S16,
+    .layout = GSCA_SL_INTERLEAVED,
+    .dither = true
+};
 
 static void gscapAtExit ()
 {
@@ -60,7 +63,7 @@ int main (int argc, char** argv)
     SDL_AudioSpec desired, obtained;
     desired.freq = GSCA_DEFAULT_SAMPLE_RATE;
     desired.channels = 2;
-    desired.format = AUDIO_F32;
+    desired.format = AUDIO_S16SYS;
     desired.samples = 8192 / 2;
     desired.callback = nullptr;
     audioDevice = SDL_OpenAudioDevice(nullptr, 0, &desired, &obtained, 0);
@@ -71,11 +74,12 @@ int main (int argc, char** argv)
     }
     SDL_PauseAudioDevice(audioDevice, 0);
 
-    apu = gscaCreateAPU();
+    apu = gscaCreateAPU(GSCA_ACC_EXACT);
+    gscaSetAPUSampleRate(apu, obtained.freq);
     store = gscaCreateAudioStore(GSCA_AS_DEFAULT_CAPACITY);
     engine = gscaCreateAudioEngine(apu, store);
+    gscaSetAudioVerification(store, true);
 
-    
     if (gscaReadAudioFile(store, argv[1]) == false)
     {
         return 1;
@@ -106,19 +110,6 @@ int main (int argc, char** argv)
 
     while (running == true)
     {
-        ticks++;
-
-        if (gscaTickAPU(apu) == true)
-        {
-            if (audioCursor + 2 <= 8192)
-            {
-                const gscaAudioSample* sample = gscaGetCurrentSample(apu);
-                audioBuffer[audioCursor++] = sample->left;
-                audioBuffer[audioCursor++] = sample->right;
-            }
-        }
-
-        if (ticks % GSCA_UPDATE_INTERVAL == 0)
         {
             SDL_Event ev;
             while (SDL_PollEvent(&ev))
@@ -163,14 +154,15 @@ int main (int argc, char** argv)
             }
 
             {
-                uint32_t queued = SDL_GetQueuedAudioSize(audioDevice);
-                if (queued < 0xFFFF)
+                // Keep the device's queue topped up. The engine's updates are
+                // run by the render itself, on the exact cycle they are due.
+                while (SDL_GetQueuedAudioSize(audioDevice) < 0x7FFF)
                 {
-                    SDL_QueueAudio(audioDevice, audioBuffer, audioCursor * sizeof(float));
-                    audioCursor = 0;
+                    size_t frames = gscaRenderEngineFormat(engine, &audioFormat,
+                        (void*[]) { audioBuffer }, 1024);
+                    SDL_QueueAudio(audioDevice, audioBuffer, frames * sizeof(gscaAudioSampleS16));
                 }
 
-                gscaUpdateAudioEngine(engine);
                 SDL_Delay(15);
             }
     